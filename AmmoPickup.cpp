@@ -1,4 +1,5 @@
 #include "AmmoPickup.h"
+#include "Compositor.h"
 
 AmmoPickup::AmmoPickup(const Weapon& weapon, const SDL_Rect& tile_rect)
 {
@@ -18,7 +19,7 @@ AmmoPickup::AmmoPickup(const Weapon& weapon, const SDL_Rect& tile_rect)
 void AmmoPickup::draw()
 {
     SDL_Rect draw_rect = Application::applyCamera(rect);
-    SDL_RenderCopy(Application::getRenderer(), texture, nullptr, &draw_rect);
+    Compositor::draw(texture, nullptr, draw_rect);
 }
 
 /**
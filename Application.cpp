@@ -1,4 +1,13 @@
 #include "Application.h"
+#include "Replay.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+#include "DynamicResolution.h"
+#include "FramePacer.h"
+#include "Input.h"
+#include "Background.h"
+#include "TextureCache.h"
+#include "MenuCanvas.h"
 
 /**
 * This namespace is used to contain all of the core game information. It is responsible
@@ -19,7 +28,6 @@ namespace Application
         SDL_Point camera;
         SDL_Point window_size;
         SDL_Point render_size;
-        SDL_Point mouse_position;
 
         // State variables.
         StateMap states;
@@ -27,7 +35,6 @@ namespace Application
         std::string current_state_name;
 
         // Resource variables.
-        std::map<std::string, SDL_Texture*> textures;
         std::map<std::string, std::map<int, TTF_Font*>> fonts;
         std::map<std::string, Mix_Chunk*> sounds;
 
@@ -42,14 +49,18 @@ namespace Application
         float delta_time;
         int frame_rate_limit;
         std::string window_title;
+
+        // The longest an idle state waits for an event, in milliseconds.
+        const int IDLE_TIMEOUT = 500;
     }
 
     /**
     * This function initializes SDL and its extensions. It also creates
     * a window, renderer. This should be one of the first functions in this namespace
-    * that is called.
+    * that is called. With "vsync", presenting a frame waits for the screen if the
+    * renderer can.
     */
-    void startUp(const std::string& title, const int screen_width, const int screen_height, const int render_width, const int render_height, const bool fullscreen, const int fps_limit)
+    void startUp(const std::string& title, const int screen_width, const int screen_height, const int render_width, const int render_height, const bool fullscreen, const int fps_limit, const bool vsync)
     {
         // Initialize SDL.
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) == -1)
@@ -92,20 +103,28 @@ namespace Application
             throw Error::SDL;
         }
 
-        // Create a renderer.
-        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-        if (renderer == nullptr)
-        {
-            throw Error::SDL;
-        }
-
+        // Create a renderer. It belongs to the render thread if there is one.
         render_size.x = render_width;
         render_size.y = render_height;
-        SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, 0);
-        SDL_RenderSetLogicalSize(Application::getRenderer(), render_size.x, render_size.y);
+        bool has_vsync = false;
+        RenderThread::call([&] {
+            renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
+            if (renderer == nullptr)
+            {
+                throw Error::SDL;
+            }
+
+            SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, 0);
+            SDL_RenderSetLogicalSize(Application::getRenderer(), render_size.x, render_size.y);
+
+            // Not every renderer can wait for vsync.
+            SDL_RendererInfo info;
+            has_vsync = SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+        });
 
         running = true;
         frame_rate_limit = fps_limit;
+        FramePacer::setup(frame_rate_limit, has_vsync);
     }
 
     /**
@@ -136,49 +155,111 @@ namespace Application
     */
     void run()
     {
-        // Variables for limiting frame rate.
-        int last_time = 0;
-        int current_time = 0;
-        int frame_time = 0;
+        // The events of the current frame.
+        std::vector<SDL_Event> frame_events;
 
         current_state->startUp();
+        FramePacer::start();
         while (running)
         {
-            // Work out the time since the last frame.
-            last_time = current_time;
-            current_time = SDL_GetTicks();
-            frame_time = current_time - last_time;
-
-            // Limit the framerate based on the time since the last frame.
-            if ((1000.0 / frame_rate_limit) > frame_time)
+            // An idle or paused state waits for an event before running a frame, which leaves
+            // the event to be polled below. A replay's events come from its file, so it never waits.
+            Background::Policy policy = Background::getPolicy();
+            if ((current_state->isIdle() || policy == Background::Policy::Pause) && Replay::getMode() != Replay::Mode::Playing)
             {
-                SDL_Delay(static_cast<Uint32>((1000.0 / frame_rate_limit) - frame_time));
+                SDL_WaitEventTimeout(nullptr, IDLE_TIMEOUT);
+                FramePacer::skip();
             }
 
-            // Calculate the current delta time.
-            delta_time = static_cast<float>(frame_time / 1000.0);
+            // Wait for this frame's turn, and work out the time since the last frame.
+            delta_time = FramePacer::wait();
 
+            // Gather this frame's events. While a replay is playing, live input is ignored.
+            frame_events.clear();
             while (SDL_PollEvent(&event))
             {
-                if (event.type == SDL_QUIT)
+                Background::handleEvent(event);
+                MenuCanvas::handleEvent(event);
+                if (Replay::getMode() != Replay::Mode::Playing || !Replay::isInputEvent(event))
+                {
+                    frame_events.push_back(event);
+                }
+            }
+
+            if (Replay::getMode() == Replay::Mode::Recording)
+            {
+                Replay::recordFrame(delta_time, frame_events);
+            }
+            else if (Replay::getMode() == Replay::Mode::Playing)
+            {
+                // The recorded delta time and events replace the live ones.
+                std::vector<SDL_Event> replay_events;
+                if (!Replay::playFrame(delta_time, replay_events))
                 {
+                    Replay::stop();
                     running = false;
+                    break;
                 }
-                else if (event.type == SDL_MOUSEMOTION)
+                frame_events.insert(frame_events.end(), replay_events.begin(), replay_events.end());
+            }
+
+            // The events are turned into a snapshot, which the state reads once.
+            Input::beginFrame();
+            for (const auto& frame_event : frame_events)
+            {
+                event = frame_event;
+                if (event.type == SDL_QUIT)
                 {
-                    mouse_position.x = event.motion.x;
-                    mouse_position.y = event.motion.y;
+                    running = false;
                 }
-                current_state->handleEvents();
+                Input::handleEvent(event);
+            }
+
+            // While paused, the input is kept up to date but nothing else happens.
+            if (policy == Background::Policy::Pause)
+            {
+                continue;
             }
+            current_state->handleEvents();
 
             current_state->update();
 
-            SDL_RenderClear(renderer);
-            current_state->draw();
-            SDL_RenderPresent(renderer);
+            if (Replay::getMode() != Replay::Mode::Off)
+            {
+                Replay::endFrame(current_state->getStateHash());
+            }
+
+            // Nothing is drawn while headless.
+            if (policy == Background::Policy::Headless)
+            {
+                continue;
+            }
+
+            // With a render thread, the frame is recorded here and drawn while the
+            // next frame is updated.
+            if (RenderThread::isRunning())
+            {
+                current_state->draw();
+                RenderThread::submitFrame();
+            }
+            else
+            {
+                Uint64 draw_start = SDL_GetPerformanceCounter();
+                SDL_RenderClear(renderer);
+                Compositor::beginFrame();
+                current_state->draw();
+                Compositor::endFrame();
+                DynamicResolution::addFrameTime(static_cast<float>(SDL_GetPerformanceCounter() - draw_start) / SDL_GetPerformanceFrequency());
+                SDL_RenderPresent(renderer);
+                Input::addPresentTime(Input::getInputTime());
+            }
         }
         current_state->shutDown();
+        Replay::stop();
+        FramePacer::logReport();
+        Input::logReport();
+        Background::logReport();
+        TextureCache::logReport();
     }
 
     /**
@@ -187,19 +268,20 @@ namespace Application
     */
     void shutDown()
     {
-        // Free every texture.
-        for (auto& texture : textures)
-        {
-            OUTPUT("Unloading texture: " << texture.first);
-            SDL_DestroyTexture(texture.second);
-        }
+        // Free every texture, and the renderer, on the thread that owns them.
+        RenderThread::call([] {
+            TextureCache::clear();
+            Compositor::clear();
+            SDL_DestroyRenderer(renderer);
+        });
+        RenderThread::stop();
 
         // Free every font.
         for (auto& font : fonts)
         {
             for (auto& font_it : font.second)
             {
-                OUTPUT("Unloading font, size " << font_it.first << ": " << font.first);
+                LOG_DEBUG("Unloading font, size " << font_it.first << ": " << font.first);
                 TTF_CloseFont(font_it.second);
             }
         }
@@ -207,12 +289,11 @@ namespace Application
         // Free every sound.
         for (auto& sound : sounds)
         {
-            OUTPUT("Unloading sound: " << sound.first);
+            LOG_DEBUG("Unloading sound: " << sound.first);
             Mix_FreeChunk(sound.second);
         }
 
         // Destroy SDL variables.
-        SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
 
         // Close down SDL and its extensions.
@@ -224,23 +305,13 @@ namespace Application
 
     /**
     * This returns a texture. If the texture hasn't been loaded, this function
-    * will load it and cache it so it doesn't have to be loaded later.
+    * will load it and cache it so it doesn't have to be loaded later. Textures
+    * that aren't pinned can be freed when the texture cache is over budget, so
+    * they shouldn't be kept hold of.
     */
-    SDL_Texture* getTexture(const std::string& file_name)
+    SDL_Texture* getTexture(const std::string& file_name, const bool pinned)
     {
-        if (textures.find(file_name) == textures.end())
-        {
-            OUTPUT("Loading texture: " << file_name);
-
-            SDL_Texture* texture = IMG_LoadTexture(renderer, file_name.c_str());
-            if (texture == nullptr)
-            {
-                throw Error::IMG;
-            }
-            textures[file_name] = texture;
-        }
-
-        return textures[file_name];
+        return TextureCache::getTexture(file_name, pinned);
     }
 
     /**
@@ -252,7 +323,7 @@ namespace Application
     {
         if (fonts.find(file_name) == fonts.end() || fonts.find(file_name)->second.find(font_size) == fonts.find(file_name)->second.end())
         {
-            OUTPUT("Loading font, size " << font_size << ": " << file_name);
+            LOG_DEBUG("Loading font, size " << font_size << ": " << file_name);
 
             TTF_Font* font = TTF_OpenFont(file_name.c_str(), font_size);
             fonts[file_name][font_size] = font;
@@ -274,7 +345,7 @@ namespace Application
     {
         if (sounds.find(file_name) == sounds.end())
         {
-            OUTPUT("Loading sound: " << file_name);
+            LOG_DEBUG("Loading sound: " << file_name);
 
             Mix_Chunk* sound = Mix_LoadWAV(file_name.c_str());
             if (sound == nullptr)
@@ -378,14 +449,6 @@ namespace Application
         return renderer;
     }
 
-    /**
-    * This function returns a pointer to the game event.
-    */
-    const SDL_Event& getEvent()
-    {
-        return event;
-    }
-
     /**
     * This function returns a reference to the camera, which can be
     * modified directly.
@@ -425,7 +488,7 @@ namespace Application
     */
     const SDL_Point& getMousePosition()
     {
-        return mouse_position;
+        return Input::getMousePosition();
     }
 
     /**
@@ -11,7 +11,7 @@
 #include <SDL_ttf.h>
 #include <tinyxml2.h>
 
-#include "Output.h"
+#include "Log.h"
 
 /**
 * This namespace is used to contain all of the core game information. It is responsible
@@ -29,7 +29,8 @@ namespace Application
         IMG,
         TTF,
         Mix,
-        XML
+        XML,
+        File
     };
 
     /**
@@ -40,10 +41,27 @@ namespace Application
     {
     public:
         virtual void startUp() = 0;
+
+        /**
+        * This method is called once a frame, after the frame's input snapshot
+        * has been built.
+        */
         virtual void handleEvents() = 0;
         virtual void update() = 0;
         virtual void draw() = 0;
         virtual void shutDown() = 0;
+
+        /**
+        * This method returns a hash of everything that affects the outcome of the state.
+        * It is used to detect when a replay goes out of sync.
+        */
+        virtual Uint64 getStateHash() { return 0; }
+
+        /**
+        * This method returns whether the state has nothing moving on its own. While it
+        * does, the game waits for events instead of running frames that change nothing.
+        */
+        virtual bool isIdle() { return false; }
     };
 
     /**
@@ -64,7 +82,6 @@ namespace Application
         extern SDL_Point camera;
         extern SDL_Point window_size;
         extern SDL_Point render_size;
-        extern SDL_Point mouse_position;
 
         // State variables.
         extern StateMap states;
@@ -72,7 +89,6 @@ namespace Application
         extern std::string current_state_name;
 
         // Resource variables.
-        extern std::map<std::string, SDL_Texture*> textures;
         extern std::map<std::string, std::map<int, TTF_Font*>> fonts;
         extern std::map<std::string, Mix_Chunk*> sounds;
 
@@ -92,9 +108,10 @@ namespace Application
     /**
     * This function initializes SDL and its extensions. It also creates
     * a window, renderer. This should be one of the first functions in this namespace
-    * that is called.
+    * that is called. With "vsync", presenting a frame waits for the screen if the
+    * renderer can.
     */
-    void startUp(const std::string& title, const int screen_width, const int screen_height, const int render_width, const int render_height, const bool fullscreen, const int fps_limit);
+    void startUp(const std::string& title, const int screen_width, const int screen_height, const int render_width, const int render_height, const bool fullscreen, const int fps_limit, const bool vsync = false);
 
     /**
     * This function sets up the game states. The "first_state_name" parameter
@@ -121,9 +138,11 @@ namespace Application
 
     /**
     * This function returns a texture. If the texture hasn't been loaded, this function
-    * will load it and cache it so it doesn't have to be loaded later.
+    * will load it and cache it so it doesn't have to be loaded later. Textures
+    * that aren't pinned can be freed when the texture cache is over budget, so
+    * they shouldn't be kept hold of.
     */
-    SDL_Texture* getTexture(const std::string& file_name);
+    SDL_Texture* getTexture(const std::string& file_name, const bool pinned = true);
 
     /**
     * This function returns a font. If the font hasn't been loaded, this function will load it and cache it so
@@ -165,11 +184,6 @@ namespace Application
     */
     SDL_Renderer* getRenderer();
 
-    /**
-    * This function returns a reference to the game event.
-    */
-    const SDL_Event& getEvent();
-
     /**
     * This function returns a reference to the camera, which can be
     * modified directly.
@@ -0,0 +1,296 @@
+#include "Autopilot.h"
+#include "DynamicResolution.h"
+#include "FramePacer.h"
+#include "TextureCache.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+/**
+* This anonymous namespace holds the autopilot settings, which are shared by every
+* state that uses the autopilot.
+*/
+namespace
+{
+    bool enabled = false;
+    float session_length = 0.0;
+    std::ofstream metrics_file;
+}
+
+/**
+* This function turns the autopilot on. The game quits after "minutes" minutes,
+* or never if "minutes" is 0. Metrics are written to "metrics_file_name".
+*/
+void Autopilot::enable(const int minutes, const std::string& metrics_file_name)
+{
+    metrics_file.open(metrics_file_name, std::ios::out | std::ios::trunc);
+    if (!metrics_file.is_open())
+    {
+        SDL_SetError(("Couldn't create metrics file: " + metrics_file_name).c_str());
+        throw Application::Error::File;
+    }
+    metrics_file << "time_s,frames,frame_mean_ms,frame_p99_ms,frame_max_ms,memory_kb,levels_completed,deaths,render_scale,stutters,texture_kb,textures_evicted,textures_reloaded" << std::endl;
+
+    enabled = true;
+    session_length = minutes * 60.0f;
+    LOG_INFO("Autopilot enabled, writing metrics to: " << metrics_file_name);
+}
+
+/**
+* This function determines if the autopilot is on.
+*/
+bool Autopilot::isEnabled()
+{
+    return enabled;
+}
+
+/**
+* This method forgets everything about the current level. It should be called
+* whenever a level starts.
+*/
+void Autopilot::reset()
+{
+    stuck_timer = 0.0;
+    unstick_timer = 0.0;
+    last_position = { 0, 0 };
+}
+
+/**
+* This method decides what the player should do this frame, and records the
+* frame's metrics.
+*/
+void Autopilot::update(Level& level, Player& player, EnemyStore& enemies, std::vector<WeaponPickup>& weapon_pickups, const SDL_Rect& exit_rect)
+{
+    steer(level, player, chooseTarget(level, player, weapon_pickups, exit_rect));
+    fight(level, player, enemies);
+
+    // Record the frame and write the metrics every so often.
+    session_time += Application::getDeltaTime();
+    metrics_timer += Application::getDeltaTime();
+    frame_times.push_back(Application::getDeltaTime());
+    if (metrics_timer >= METRICS_TIME)
+    {
+        metrics_timer = 0.0;
+        writeMetrics();
+    }
+
+    if (session_length > 0.0 && session_time >= session_length)
+    {
+        writeMetrics();
+        LOG_INFO("Autopilot session finished after " << session_time << " seconds");
+        Application::quit();
+    }
+}
+
+/**
+* This method records that the player reached the exit.
+*/
+void Autopilot::levelCompleted()
+{
+    levels_completed++;
+}
+
+/**
+* This method records that the player died.
+*/
+void Autopilot::playerDied()
+{
+    deaths++;
+}
+
+/**
+* This method picks the tile the player should head for.
+*/
+SDL_Point Autopilot::chooseTarget(Level& level, Player& player, std::vector<WeaponPickup>& weapon_pickups, const SDL_Rect& exit_rect)
+{
+    SDL_Point centre = player.getCentre();
+    SDL_Point target = { (exit_rect.x + (exit_rect.w / 2)) / Level::TILE_SIZE, (exit_rect.y + (exit_rect.h / 2)) / Level::TILE_SIZE };
+
+    // Go for the closest weapon the player doesn't have yet, as long as it can be reached.
+    int closest_distance = std::numeric_limits<int>::max();
+    for (auto& weapon_pickup : weapon_pickups)
+    {
+        if (player.hasWeapon(weapon_pickup.getWeapon()))
+        {
+            continue;
+        }
+
+        const SDL_Rect& rect = weapon_pickup.getRect();
+        SDL_Point tile = { (rect.x + (rect.w / 2)) / Level::TILE_SIZE, (rect.y + (rect.h / 2)) / Level::TILE_SIZE };
+        int distance = std::abs(rect.x - centre.x) + std::abs(rect.y - centre.y);
+        if (distance < closest_distance && level.hasPathToTile(tile))
+        {
+            closest_distance = distance;
+            target = tile;
+        }
+    }
+
+    return target;
+}
+
+/**
+* This method moves the player along the path to the target tile.
+*/
+void Autopilot::steer(Level& level, Player& player, const SDL_Point& target_tile)
+{
+    SDL_Point centre = player.getCentre();
+    SDL_Point tile = { centre.x / Level::TILE_SIZE, centre.y / Level::TILE_SIZE };
+
+    // If the player hasn't moved for a while it's caught on a wall or an enemy,
+    // so it moves in a random direction for a moment.
+    stuck_timer += Application::getDeltaTime();
+    if (std::abs(centre.x - last_position.x) + std::abs(centre.y - last_position.y) > STUCK_DISTANCE)
+    {
+        last_position = centre;
+        stuck_timer = 0.0;
+    }
+    else if (stuck_timer >= STUCK_TIME)
+    {
+        stuck_timer = 0.0;
+        unstick_timer = UNSTICK_TIME;
+        unstick_direction = { random.nextInt(-1, 1), random.nextInt(-1, 1) };
+    }
+
+    if (unstick_timer > 0.0)
+    {
+        unstick_timer -= Application::getDeltaTime();
+        player.setMovement(unstick_direction.x, unstick_direction.y);
+        return;
+    }
+
+    // The target's field leads to it from every tile, and is shared with anything
+    // else heading for the same tile.
+    NavigationField& field = level.getNavigation().getField(target_tile);
+    if (!field.isReachable(tile))
+    {
+        player.setMovement(0, 0);
+        return;
+    }
+    SDL_Point next = field.getNextTile(tile);
+
+    // Head for the centre of the next tile.
+    look_point = { (next.x * Level::TILE_SIZE) + (Level::TILE_SIZE / 2), (next.y * Level::TILE_SIZE) + (Level::TILE_SIZE / 2) };
+    int dx = look_point.x - centre.x;
+    int dy = look_point.y - centre.y;
+    player.setMovement(
+        dx > DEAD_ZONE ? 1 : (dx < -DEAD_ZONE ? -1 : 0),
+        dy > DEAD_ZONE ? 1 : (dy < -DEAD_ZONE ? -1 : 0)
+    );
+}
+
+/**
+* This method aims at the closest visible enemy and shoots it until it dies or
+* can't be seen. If there isn't one, the player looks where it's going.
+*/
+void Autopilot::fight(Level& level, Player& player, EnemyStore& enemies)
+{
+    SDL_Point centre = player.getCentre();
+    auto centreOf = [](const SDL_Rect& rect) -> SDL_Point {
+        return { rect.x + (rect.w / 2), rect.y + (rect.h / 2) };
+    };
+
+    // Keep shooting the same enemy while it can still be seen, otherwise pick the
+    // closest one that can.
+    int target_index = has_target ? enemies.find(target) : -1;
+    if (target_index >= 0 && !level.isInLineOfSight(centre, centreOf(enemies.getRects()[target_index])))
+    {
+        target_index = -1;
+    }
+    if (target_index < 0)
+    {
+        int closest_distance = SIGHT_RANGE * SIGHT_RANGE;
+        const std::vector<SDL_Rect>& rects = enemies.getRects();
+        for (std::size_t i = 0; i < rects.size(); i++)
+        {
+            SDL_Point enemy_centre = centreOf(rects[i]);
+            int dx = enemy_centre.x - centre.x;
+            int dy = enemy_centre.y - centre.y;
+            int distance = (dx * dx) + (dy * dy);
+            if (distance < closest_distance && level.isInLineOfSight(centre, enemy_centre))
+            {
+                closest_distance = distance;
+                target_index = static_cast<int>(i);
+            }
+        }
+    }
+
+    has_target = target_index >= 0;
+    if (has_target)
+    {
+        target = enemies.getHandle(target_index);
+
+        // Switch to a weapon that has ammo before shooting.
+        if (!player.hasAmmo())
+        {
+            player.changeWeapon(1);
+        }
+
+        player.aimAt(centreOf(enemies.getRects()[target_index]));
+        player.setShooting(true);
+    }
+    else
+    {
+        player.aimAt(look_point);
+        player.setShooting(false);
+    }
+}
+
+/**
+* This method writes a line of metrics to the metrics file.
+*/
+void Autopilot::writeMetrics()
+{
+    if (frame_times.empty())
+    {
+        return;
+    }
+
+    std::sort(frame_times.begin(), frame_times.end());
+    float total = 0.0;
+    for (const auto& frame_time : frame_times)
+    {
+        total += frame_time;
+    }
+
+    float mean_ms = (total / frame_times.size()) * 1000.0f;
+    float p99_ms = frame_times[(frame_times.size() * 99) / 100] * 1000.0f;
+    float max_ms = frame_times.back() * 1000.0f;
+    long memory = getResidentMemory();
+
+    metrics_file << session_time << "," << frame_times.size() << "," << mean_ms << "," << p99_ms << "," << max_ms << ","
+        << memory << "," << levels_completed << "," << deaths << "," << DynamicResolution::getScale() << "," << FramePacer::getStutterCount() << ","
+        << TextureCache::getResidentBytes() / 1024 << "," << TextureCache::getEvictedCount() << "," << TextureCache::getReloadCount() << std::endl;
+    LOG_INFO("Autopilot: " << session_time << "s, mean " << mean_ms << "ms, p99 " << p99_ms << "ms, max " << max_ms << "ms, " << memory << "KB");
+
+    frame_times.clear();
+}
+
+/**
+* This function returns how much memory the game is using, in kilobytes.
+*/
+long Autopilot::getResidentMemory()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<long>(counters.WorkingSetSize / 1024);
+    }
+    return 0;
+#elif defined(__linux__)
+    long pages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> pages;
+    return pages * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Level.h"
+#include "Player.h"
+#include "EnemyStore.h"
+#include "AmmoPickup.h"
+
+#include <fstream>
+
+/**
+* This class plays the game on its own, so that long soak and throughput runs don't
+* need anybody at the keyboard. It drives the player towards weapons it doesn't have
+* and then the exit, and shoots at any enemy it can see. While it plays it records
+* frame times and memory use to a metrics file.
+*/
+class Autopilot
+{
+public:
+    /**
+    * This function turns the autopilot on. The game quits after "minutes" minutes,
+    * or never if "minutes" is 0. Metrics are written to "metrics_file_name".
+    */
+    static void enable(const int minutes, const std::string& metrics_file_name);
+
+    /**
+    * This function determines if the autopilot is on.
+    */
+    static bool isEnabled();
+
+    /**
+    * This method forgets everything about the current level. It should be called
+    * whenever a level starts.
+    */
+    void reset();
+
+    /**
+    * This method decides what the player should do this frame, and records the
+    * frame's metrics.
+    */
+    void update(Level& level, Player& player, EnemyStore& enemies, std::vector<WeaponPickup>& weapon_pickups, const SDL_Rect& exit_rect);
+
+    /**
+    * This method records that the player reached the exit.
+    */
+    void levelCompleted();
+
+    /**
+    * This method records that the player died.
+    */
+    void playerDied();
+
+private:
+    /**
+    * This method picks the tile the player should head for.
+    */
+    SDL_Point chooseTarget(Level& level, Player& player, std::vector<WeaponPickup>& weapon_pickups, const SDL_Rect& exit_rect);
+
+    /**
+    * This method moves the player along the path to the target tile.
+    */
+    void steer(Level& level, Player& player, const SDL_Point& target_tile);
+
+    /**
+    * This method aims at the closest visible enemy and shoots it until it dies or
+    * can't be seen. If there isn't one, the player looks where it's going.
+    */
+    void fight(Level& level, Player& player, EnemyStore& enemies);
+
+    /**
+    * This method writes a line of metrics to the metrics file.
+    */
+    void writeMetrics();
+
+    /**
+    * This function returns how much memory the game is using, in kilobytes.
+    */
+    static long getResidentMemory();
+
+private:
+    static constexpr float METRICS_TIME = 60.0;
+    static constexpr float STUCK_TIME = 1.5;
+    static constexpr float UNSTICK_TIME = 0.5;
+    static const int STUCK_DISTANCE = 5;
+    static const int SIGHT_RANGE = 12 * Level::TILE_SIZE;
+    static const int DEAD_ZONE = 4;
+
+    Random::Generator random;
+    SDL_Point look_point;
+    EnemyStore::Handle target;
+    bool has_target = false;
+
+    // Stuck detection.
+    SDL_Point last_position = { 0, 0 };
+    float stuck_timer = 0.0;
+    float unstick_timer = 0.0;
+    SDL_Point unstick_direction = { 0, 0 };
+
+    // Metrics.
+    float session_time = 0.0;
+    float metrics_timer = 0.0;
+    std::vector<float> frame_times;
+    int levels_completed = 0;
+    int deaths = 0;
+};
\ No newline at end of file
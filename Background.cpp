@@ -0,0 +1,212 @@
+#include "Background.h"
+#include "FramePacer.h"
+#include "Replay.h"
+
+#include <ctime>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+/**
+* This namespace decides what the game does while its window doesn't have focus or
+* is minimised. Each has its own policy:
+*
+* "Run" carries on as normal.
+* "Pause" stops updating and drawing, pauses the sound, and waits for events, so the
+*   game uses almost no CPU.
+* "Throttle" carries on updating and drawing at a low frame rate.
+* "Headless" carries on updating at the normal frame rate, but doesn't draw anything.
+*
+* Whichever policy was in use, the first frame back has a normal delta time. While a
+* replay is being recorded or played, the game always runs, so the replay matches.
+*
+* The CPU time used while the window was in the background is measured, and logged
+* when the window comes back.
+*/
+namespace Background
+{
+    /**
+    * This anonymous namespace holds the policies, the state of the window, and the
+    * time spent in the background.
+    */
+    namespace
+    {
+        Policy unfocused_policy = Policy::Run;
+        Policy minimised_policy = Policy::Run;
+        int throttle_rate = DEFAULT_THROTTLE_RATE;
+
+        bool focused = true;
+        bool minimised = false;
+        Policy current_policy = Policy::Run;
+
+        // When the window went into the background, and the totals so far.
+        Uint64 background_start = 0;
+        double background_cpu_start = 0.0;
+        double total_time = 0.0;
+        double total_cpu_time = 0.0;
+
+        /**
+        * This function returns how much CPU time every thread of the game has
+        * used, in seconds.
+        */
+        double getCpuTime()
+        {
+#if defined(_WIN32)
+            FILETIME creation, exit, kernel, user;
+            if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            {
+                ULARGE_INTEGER kernel_time = { { kernel.dwLowDateTime, kernel.dwHighDateTime } };
+                ULARGE_INTEGER user_time = { { user.dwLowDateTime, user.dwHighDateTime } };
+                return static_cast<double>(kernel_time.QuadPart + user_time.QuadPart) / 10000000.0;
+            }
+            return 0.0;
+#else
+            return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+        }
+
+        /**
+        * This function changes to a new policy, and starts or stops measuring the
+        * time spent in the background.
+        */
+        void changePolicy(const Policy policy)
+        {
+            if (policy == current_policy)
+            {
+                return;
+            }
+
+            if (current_policy == Policy::Pause)
+            {
+                Mix_Resume(-1);
+                Mix_ResumeMusic();
+            }
+            if (policy == Policy::Pause)
+            {
+                Mix_Pause(-1);
+                Mix_PauseMusic();
+            }
+
+            // Nothing is presented while headless, so the pacer has to wait by itself.
+            FramePacer::setThrottle(policy == Policy::Throttle ? throttle_rate : policy == Policy::Headless ? FramePacer::getFrameRate() : 0);
+            FramePacer::skip();
+
+            if (current_policy == Policy::Run)
+            {
+                background_start = SDL_GetPerformanceCounter();
+                background_cpu_start = getCpuTime();
+            }
+            else if (policy == Policy::Run)
+            {
+                double time = static_cast<double>(SDL_GetPerformanceCounter() - background_start) / SDL_GetPerformanceFrequency();
+                double cpu_time = getCpuTime() - background_cpu_start;
+                total_time += time;
+                total_cpu_time += cpu_time;
+                LOG_INFO("Back from the background after " << time << "s, which used " << (time > 0.0 ? (cpu_time * 100.0) / time : 0.0) << "% of a CPU core");
+            }
+            current_policy = policy;
+        }
+    }
+
+    /**
+    * This function sets the policies for when the window doesn't have focus and when
+    * it's minimised, and the frame rate "Throttle" runs at.
+    */
+    void setup(const Policy unfocused, const Policy minimised, const int throttle_rate)
+    {
+        unfocused_policy = unfocused;
+        minimised_policy = minimised;
+        Background::throttle_rate = throttle_rate > 0 ? throttle_rate : DEFAULT_THROTTLE_RATE;
+    }
+
+    /**
+    * This function keeps track of whether the window has focus and can be seen.
+    */
+    void handleEvent(const SDL_Event& event)
+    {
+        if (event.type != SDL_WINDOWEVENT)
+        {
+            return;
+        }
+
+        switch (event.window.event)
+        {
+        case SDL_WINDOWEVENT_FOCUS_GAINED:
+            focused = true;
+            break;
+        case SDL_WINDOWEVENT_FOCUS_LOST:
+            focused = false;
+            break;
+        case SDL_WINDOWEVENT_MINIMIZED:
+        case SDL_WINDOWEVENT_HIDDEN:
+            minimised = true;
+            break;
+        case SDL_WINDOWEVENT_RESTORED:
+        case SDL_WINDOWEVENT_MAXIMIZED:
+        case SDL_WINDOWEVENT_SHOWN:
+            minimised = false;
+            break;
+        default:
+            return;
+        }
+        changePolicy(getPolicy());
+    }
+
+    /**
+    * This function returns the policy in use right now.
+    */
+    Policy getPolicy()
+    {
+        if (Replay::getMode() != Replay::Mode::Off)
+        {
+            return Policy::Run;
+        }
+        else if (minimised)
+        {
+            return minimised_policy;
+        }
+        else if (!focused)
+        {
+            return unfocused_policy;
+        }
+        return Policy::Run;
+    }
+
+    /**
+    * This function returns the policy a config setting names. Anything else is "Run".
+    */
+    Policy toPolicy(const std::string& name)
+    {
+        if (name == "Pause")
+        {
+            return Policy::Pause;
+        }
+        else if (name == "Throttle")
+        {
+            return Policy::Throttle;
+        }
+        else if (name == "Headless")
+        {
+            return Policy::Headless;
+        }
+        return Policy::Run;
+    }
+
+    /**
+    * This function writes the time spent in the background, and the CPU time used
+    * during it, to the log.
+    */
+    void logReport()
+    {
+        // Quitting while in the background still counts the time so far.
+        if (current_policy != Policy::Run)
+        {
+            changePolicy(Policy::Run);
+        }
+        if (total_time > 0.0)
+        {
+            LOG_INFO("In the background for " << total_time << "s in total, using " << total_cpu_time << "s of CPU time");
+        }
+    }
+}
\ No newline at end of file
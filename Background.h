@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This namespace decides what the game does while its window doesn't have focus or
+* is minimised. Each has its own policy:
+*
+* "Run" carries on as normal.
+* "Pause" stops updating and drawing, pauses the sound, and waits for events, so the
+*   game uses almost no CPU.
+* "Throttle" carries on updating and drawing at a low frame rate.
+* "Headless" carries on updating at the normal frame rate, but doesn't draw anything.
+*
+* Whichever policy was in use, the first frame back has a normal delta time. While a
+* replay is being recorded or played, the game always runs, so the replay matches.
+*
+* The CPU time used while the window was in the background is measured, and logged
+* when the window comes back.
+*/
+namespace Background
+{
+    enum class Policy
+    {
+        Run,
+        Pause,
+        Throttle,
+        Headless
+    };
+
+    /**
+    * This function sets the policies for when the window doesn't have focus and when
+    * it's minimised, and the frame rate "Throttle" runs at.
+    */
+    void setup(const Policy unfocused, const Policy minimised, const int throttle_rate);
+
+    /**
+    * This function keeps track of whether the window has focus and can be seen.
+    */
+    void handleEvent(const SDL_Event& event);
+
+    /**
+    * This function returns the policy in use right now.
+    */
+    Policy getPolicy();
+
+    /**
+    * This function returns the policy a config setting names. Anything else is "Run".
+    */
+    Policy toPolicy(const std::string& name);
+
+    /**
+    * This function writes the time spent in the background, and the CPU time used
+    * during it, to the log.
+    */
+    void logReport();
+
+    const int DEFAULT_THROTTLE_RATE = 10;
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+/**
+* This namespace contains a small benchmarking harness. Each benchmark is a function
+* that is timed over many runs, and the results can be written out as JSON so they
+* can be compared between builds.
+*/
+namespace Benchmark
+{
+    /**
+    * This variable is written to by "doNotOptimize".
+    */
+    volatile char sink;
+
+    /**
+    * This anonymous namespace holds the benchmark settings and results.
+    */
+    namespace
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        // A batch of calls has to take at least this long to be timed accurately.
+        const double MINIMUM_BATCH_NS = 1000000.0;
+        const int MINIMUM_SAMPLES = 5;
+
+        double minimum_time = 0.5;
+        std::vector<Result> results;
+
+        /**
+        * This function writes a string to a JSON stream, escaping any characters
+        * that need escaping.
+        */
+        void writeString(std::ostream& out, const std::string& string)
+        {
+            out << '"';
+            for (const auto& character : string)
+            {
+                if (character == '"' || character == '\\')
+                {
+                    out << '\\';
+                }
+                out << character;
+            }
+            out << '"';
+        }
+    }
+
+    /**
+    * This function sets how long each benchmark is run for.
+    */
+    void setMinimumTime(const double seconds)
+    {
+        minimum_time = seconds;
+    }
+
+    /**
+    * This function times a function and stores the result. The function is called
+    * in batches that are big enough to be timed accurately, until the minimum time
+    * has passed.
+    */
+    void run(const std::string& name, const Parameters& parameters, const std::function<void()>& function)
+    {
+        // Work out how many calls make up a batch, starting from a single call.
+        long long batch_size = 1;
+        while (true)
+        {
+            auto start = Clock::now();
+            for (long long i = 0; i < batch_size; i++)
+            {
+                function();
+            }
+            double batch_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            if (batch_ns >= MINIMUM_BATCH_NS || batch_size >= (1LL << 30))
+            {
+                break;
+            }
+            batch_size *= 2;
+        }
+
+        // Time batches until enough time has passed and there are enough samples.
+        std::vector<double> samples;
+        double total_ns = 0.0;
+        while (total_ns < minimum_time * 1e9 || samples.size() < MINIMUM_SAMPLES)
+        {
+            auto start = Clock::now();
+            for (long long i = 0; i < batch_size; i++)
+            {
+                function();
+            }
+            double batch_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            samples.push_back(batch_ns / batch_size);
+            total_ns += batch_ns;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.parameters = parameters;
+        result.iterations = batch_size * static_cast<long long>(samples.size());
+        result.mean_ns = (total_ns / result.iterations);
+        result.median_ns = samples[samples.size() / 2];
+        result.min_ns = samples.front();
+        result.max_ns = samples.back();
+        results.push_back(result);
+
+        std::cout << name;
+        for (const auto& parameter : parameters)
+        {
+            std::cout << " " << parameter.first << "=" << parameter.second;
+        }
+        std::cout << ": " << result.median_ns << " ns" << std::endl;
+    }
+
+    /**
+    * This function returns the results of every benchmark run so far.
+    */
+    const std::vector<Result>& getResults()
+    {
+        return results;
+    }
+
+    /**
+    * This function writes the results of every benchmark run so far as JSON.
+    */
+    void writeJson(std::ostream& out)
+    {
+        out << "{\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); i++)
+        {
+            const Result& result = results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\n      \"name\": ";
+            writeString(out, result.name);
+
+            out << ",\n      \"parameters\": {";
+            bool first = true;
+            for (const auto& parameter : result.parameters)
+            {
+                out << (first ? " " : ", ");
+                writeString(out, parameter.first);
+                out << ": " << parameter.second;
+                first = false;
+            }
+            out << (first ? "}" : " }");
+
+            out << ",\n      \"iterations\": " << result.iterations;
+            out << ",\n      \"mean_ns\": " << result.mean_ns;
+            out << ",\n      \"median_ns\": " << result.median_ns;
+            out << ",\n      \"min_ns\": " << result.min_ns;
+            out << ",\n      \"max_ns\": " << result.max_ns;
+            out << "\n    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+* This namespace contains a small benchmarking harness. Each benchmark is a function
+* that is timed over many runs, and the results can be written out as JSON so they
+* can be compared between builds.
+*/
+namespace Benchmark
+{
+    /**
+    * This typedef is a map of the parameters a benchmark was run with, such
+    * as the size of the level.
+    */
+    typedef std::map<std::string, int> Parameters;
+
+    /**
+    * This struct holds the timings of a single benchmark. Every time is the
+    * time taken by one call of the benchmarked function.
+    */
+    struct Result
+    {
+        std::string name;
+        Parameters parameters;
+        long long iterations;
+        double mean_ns;
+        double median_ns;
+        double min_ns;
+        double max_ns;
+    };
+
+    /**
+    * This function sets how long each benchmark is run for.
+    */
+    void setMinimumTime(const double seconds);
+
+    /**
+    * This function times a function and stores the result. The function is called
+    * in batches that are big enough to be timed accurately, until the minimum time
+    * has passed.
+    */
+    void run(const std::string& name, const Parameters& parameters, const std::function<void()>& function);
+
+    /**
+    * This function returns the results of every benchmark run so far.
+    */
+    const std::vector<Result>& getResults();
+
+    /**
+    * This function writes the results of every benchmark run so far as JSON.
+    */
+    void writeJson(std::ostream& out);
+
+    /**
+    * This variable is written to by "doNotOptimize".
+    */
+    extern volatile char sink;
+
+    /**
+    * This function stops the compiler from optimizing away a value that is
+    * computed but never used.
+    */
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+        sink = *reinterpret_cast<const volatile char*>(&value);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,453 @@
+#include "Benchmark.h"
+#include "../Level.h"
+#include "../EnemyStore.h"
+#include "../LevelGenerator.h"
+#include "../Text.h"
+#include "../TileRasterizer.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+/**
+* This program benchmarks the functions the game spends most of its time in. It has to be
+* run from the game's folder because it loads the game's textures and font, and it needs
+* every game source file except main.cpp, plus Benchmark.cpp.
+*
+* Usage:
+*   Benchmarks [-sizes 64,128,256] [-enemies 16] [-projectiles 100,1000] [-seed N]
+*              [-time 0.5] [-out results.json]
+*
+* Every size is a square level generated by LevelGenerator. The results are printed as they
+* finish, and written as JSON to the "-out" file.
+*/
+namespace
+{
+    const std::string LEVEL_FILE = "BenchmarkLevel.xml";
+
+    /**
+    * This function splits a comma separated list of numbers.
+    */
+    std::vector<int> parseList(const std::string& text)
+    {
+        std::vector<int> list;
+        for (const auto& item : Tools::splitText(text, ','))
+        {
+            list.push_back(atoi(item.c_str()));
+        }
+        return list;
+    }
+
+    /**
+    * This function returns the centre of a rect.
+    */
+    SDL_Point centreOf(const SDL_Rect& rect)
+    {
+        return { rect.x + (rect.w / 2), rect.y + (rect.h / 2) };
+    }
+
+    /**
+    * This function runs every level benchmark on a generated level of one size.
+    */
+    void benchmarkLevel(const int size, const int enemy_count, const std::vector<int>& projectile_counts, const Uint64 seed)
+    {
+        // The enemies are split evenly between the four enemy types.
+        LevelGenerator::Settings settings;
+        settings.width = size;
+        settings.height = size;
+        settings.seed = seed;
+        settings.room_count = (size * size) / 512;
+        for (int type = 0; type < 4; type++)
+        {
+            settings.enemy_counts[type] = (enemy_count / 4) + (type < (enemy_count % 4) ? 1 : 0);
+        }
+        LevelGenerator generator(settings);
+        generator.generate();
+        generator.save(LEVEL_FILE);
+
+        Benchmark::Parameters parameters = { { "size", size } };
+        Level level;
+
+        Benchmark::run("Level::load", parameters, [&] {
+            level.load(LEVEL_FILE);
+        });
+
+        SDL_Point player_tile = { level.getObjects('1')[0].x / Level::TILE_SIZE, level.getObjects('1')[0].y / Level::TILE_SIZE };
+        SDL_Point exit_tile = { level.getObjects('H')[0].x / Level::TILE_SIZE, level.getObjects('H')[0].y / Level::TILE_SIZE };
+
+        // The player's field is cached, so it's invalidated to make it build every time.
+        Benchmark::run("Level::updateNavigation", parameters, [&] {
+            level.getNavigation().invalidate();
+            level.updateNavigation(player_tile);
+        });
+
+        // The exit is the furthest tile from the player, so this is the longest path.
+        Benchmark::run("Level::getPathToTile", parameters, [&] {
+            Benchmark::doNotOptimize(level.getPathToTile(exit_tile).size());
+        });
+
+        // The same route with Jump Point Search, to compare against building a whole
+        // navigation field. The number of tiles it opened is reported as a parameter.
+        JumpPointSearch& planner = level.getPlanner();
+        std::deque<SDL_Point> planned_path;
+        planner.findPath(player_tile, exit_tile, planned_path);
+        Benchmark::Parameters planner_parameters = { { "size", size }, { "expanded", planner.getExpandedCount() } };
+        Benchmark::run("JumpPointSearch::findPath", planner_parameters, [&] {
+            Benchmark::doNotOptimize(planner.findPath(player_tile, exit_tile, planned_path));
+        });
+
+        // Every tile with an object on it is a floor tile, so those are used whenever
+        // the benchmarks need floor tiles.
+        std::vector<SDL_Rect> floor_tiles;
+        std::vector<SDL_Point> enemy_centres;
+        for (char type = '1'; type <= 'H'; type++)
+        {
+            for (const auto& rect : level.getObjects(type))
+            {
+                floor_tiles.push_back(rect);
+                if (type >= '2' && type <= '5')
+                {
+                    enemy_centres.push_back(centreOf(rect));
+                }
+            }
+        }
+
+        // Enemies heading for a handful of different tiles, like pickups, share fields,
+        // so most of these are cache hits. The hit rate is reported as a parameter.
+        NavigationCache& navigation = level.getNavigation();
+        std::size_t target_index = 0;
+        auto getTargetField = [&] {
+            const SDL_Rect& target = floor_tiles[(target_index++ * 7) % std::min<std::size_t>(floor_tiles.size(), 8)];
+            Benchmark::doNotOptimize(navigation.getField({ target.x / Level::TILE_SIZE, target.y / Level::TILE_SIZE }).getVersion());
+        };
+        Uint64 hits = navigation.getHitCount();
+        for (int i = 0; i < 64; i++)
+        {
+            getTargetField();
+        }
+        int hit_rate = static_cast<int>(((navigation.getHitCount() - hits) * 100) / 64);
+        Benchmark::Parameters cache_parameters = { { "size", size }, { "hit_rate", hit_rate } };
+        Benchmark::run("NavigationCache::getField", cache_parameters, getTargetField);
+
+        // Every enemy and the player check the tiles around them every frame.
+        std::size_t tile_index = 0;
+        Benchmark::run("Level::getSurroundingSolids", parameters, [&] {
+            const SDL_Rect& tile = floor_tiles[tile_index];
+            Benchmark::doNotOptimize(level.getSurroundingSolids(tile.x / Level::TILE_SIZE, tile.y / Level::TILE_SIZE).size());
+            tile_index = (tile_index + 1) % floor_tiles.size();
+        });
+
+        Benchmark::run("Level::getObjects", parameters, [&] {
+            Benchmark::doNotOptimize(level.getObjects('2').size());
+        });
+
+        // Building the potentially visible set for the whole level, which is done when
+        // small levels are loaded. Its size is reported as a parameter.
+        Visibility& visibility = level.getVisibility();
+        visibility.buildAll();
+        Benchmark::Parameters visibility_parameters = { { "size", size }, { "memory_kb", static_cast<int>(visibility.getMemory() / 1024) } };
+        Benchmark::run("Visibility::buildAll", visibility_parameters, [&] {
+            visibility.reset();
+            visibility.buildAll();
+        });
+
+        // This is the check every enemy does every frame to see if it can see the player.
+        Benchmark::Parameters sight_parameters = { { "size", size }, { "enemies", static_cast<int>(enemy_centres.size()) } };
+        SDL_Point player_centre = centreOf(level.getObjects('1')[0]);
+        Benchmark::run("Enemy line of sight", sight_parameters, [&] {
+            int visible = 0;
+            for (const auto& centre : enemy_centres)
+            {
+                visible += level.isInLineOfSight(centre, player_centre) ? 1 : 0;
+            }
+            Benchmark::doNotOptimize(visible);
+        });
+
+        // This is a whole frame of enemy AI, with every enemy in the level and the player
+        // at the start. Most enemies are far from the player, so this shows how much work
+        // the AI scheduler saves.
+        Player player;
+        player.setTile(level.getObjects('1')[0]);
+        EnemyStore enemies;
+        for (int type = 0; type < static_cast<int>(EnemyType::Count); type++)
+        {
+            for (const auto& tile : level.getObjects(static_cast<char>('2' + type)))
+            {
+                enemies.spawn(static_cast<EnemyType>(type), tile);
+            }
+        }
+        std::vector<Projectile> enemy_projectiles;
+        Benchmark::run("EnemyStore::update", sight_parameters, [&] {
+            enemies.update(level, player, enemy_projectiles);
+            enemy_projectiles.clear();
+        });
+
+        // The projectiles sit in the middle of floor tiles, so none of them are removed
+        // and every run does the same amount of work.
+        for (const auto& projectile_count : projectile_counts)
+        {
+            std::vector<Projectile> projectiles;
+            for (int i = 0; i < projectile_count; i++)
+            {
+                projectiles.emplace_back(Weapon::Handgun, centreOf(floor_tiles[i % floor_tiles.size()]), 0);
+            }
+
+            Benchmark::Parameters projectile_parameters = { { "size", size }, { "projectiles", projectile_count } };
+            Benchmark::run("GameState projectile/wall pass", projectile_parameters, [&] {
+                level.removeProjectilesInSolids(projectiles);
+            });
+        }
+
+        std::remove(LEVEL_FILE.c_str());
+    }
+
+    /**
+    * This function runs the benchmarks for the functions in Tools and Text.
+    */
+    void benchmarkTools(const std::vector<int>& sizes)
+    {
+        // Split text the same size as a layer of each level.
+        for (const auto& size : sizes)
+        {
+            std::string row(size, '1');
+            std::string layer_text;
+            for (int y = 0; y < size; y++)
+            {
+                layer_text += (y == 0 ? "" : " ") + row;
+            }
+
+            Benchmark::run("Tools::splitText", { { "size", size } }, [&] {
+                Benchmark::doNotOptimize(Tools::splitText(layer_text, ' ').size());
+            });
+        }
+
+        std::vector<SDL_Point> points(1024);
+        Random::Generator random(1);
+        for (auto& point : points)
+        {
+            point = { random.nextInt(0, 2048 * Level::TILE_SIZE), random.nextInt(0, 2048 * Level::TILE_SIZE) };
+        }
+        std::size_t point_index = 0;
+        Benchmark::run("Tools::angleBetweenPoints", {}, [&] {
+            const SDL_Point& a = points[point_index];
+            const SDL_Point& b = points[(point_index + 1) % points.size()];
+            Benchmark::doNotOptimize(Tools::angleBetweenPoints(a.x, a.y, b.x, b.y));
+            point_index = (point_index + 1) % points.size();
+        });
+
+        // This is what the ammo counter does every time the player shoots.
+        Text text(Application::getFont("Resources/Fonts/GameFont.ttf", 24), "", 20, 20, false, { 255, 255, 255, 255 });
+        int ammo = 0;
+        Benchmark::run("Text::setText", {}, [&] {
+            text.setText("Ammo: " + std::to_string(ammo++ % 200));
+        });
+    }
+
+    /**
+    * This function draws the same frame with every blend loop the CPU supports, with the
+    * tiled rasterizer on different numbers of threads, and with SDL's software renderer. The frame is the level filling the screen, some sprites,
+    * a few of them stretched, and a line of text.
+    */
+    void benchmarkBlitter(const int sprite_count)
+    {
+        const SDL_Point& size = Application::getRenderSize();
+        Random::Generator random(1);
+
+        // The level has no transparent pixels, the sprites are round with soft edges,
+        // and the text is mostly transparent.
+        const int sprite_size = 32;
+        const SDL_Point text_size = { 200, 24 };
+        std::vector<Uint32> level_pixels(static_cast<std::size_t>(size.x) * 2 * size.y * 2);
+        for (auto& pixel : level_pixels)
+        {
+            pixel = 0xFF000000 | static_cast<Uint32>(random.nextInt(0, 0xFFFFFF));
+        }
+        std::vector<Uint32> sprite_pixels(sprite_size * sprite_size);
+        for (int y = 0; y < sprite_size; y++)
+        {
+            for (int x = 0; x < sprite_size; x++)
+            {
+                float distance = std::sqrt(static_cast<float>(((x - 16) * (x - 16)) + ((y - 16) * (y - 16))));
+                Uint32 alpha = static_cast<Uint32>(std::max(0.0f, std::min(255.0f, (15.0f - distance) * 128.0f)));
+                sprite_pixels[(y * sprite_size) + x] = (alpha << 24) | 0x40A040;
+            }
+        }
+        std::vector<Uint32> text_pixels(text_size.x * text_size.y);
+        for (auto& pixel : text_pixels)
+        {
+            int coverage = random.nextInt(0, 3);
+            pixel = coverage == 0 ? 0 : coverage == 3 ? 0xFFFFFFFF : (static_cast<Uint32>(random.nextInt(1, 254)) << 24) | 0xFFFFFF;
+        }
+
+        std::vector<SDL_Rect> sprite_rects(sprite_count);
+        for (auto& rect : sprite_rects)
+        {
+            rect = { random.nextInt(-sprite_size / 2, size.x - (sprite_size / 2)), random.nextInt(-sprite_size / 2, size.y - (sprite_size / 2)), sprite_size, sprite_size };
+        }
+        SDL_Rect camera = { size.x / 2, size.y / 2, size.x, size.y };
+        SDL_Rect screen = { 0, 0, size.x, size.y };
+        SDL_Rect text_rect = { 20, 20, text_size.x, text_size.y };
+        const int stretched_count = 8;
+
+        Blitter::Image frame, level, sprite, text;
+        Blitter::resize(frame, size.x, size.y);
+        Blitter::load(level, level_pixels.data(), size.x * 2, size.y * 2, size.x * 2 * 4);
+        Blitter::load(sprite, sprite_pixels.data(), sprite_size, sprite_size, sprite_size * 4);
+        Blitter::load(text, text_pixels.data(), text_size.x, text_size.y, text_size.x * 4);
+
+        Blitter::Kernel best = Blitter::getBestKernel();
+        for (int kernel = 0; kernel <= static_cast<int>(best); kernel++)
+        {
+            Blitter::setKernel(static_cast<Blitter::Kernel>(kernel));
+            Benchmark::run(std::string("Blitter frame (") + Blitter::getKernelName(Blitter::getKernel()) + ")", { { "sprites", sprite_count } }, [&] {
+                Blitter::blit(frame, level, &camera, screen);
+                for (const auto& rect : sprite_rects)
+                {
+                    Blitter::blit(frame, sprite, nullptr, rect);
+                }
+                for (int i = 0; i < stretched_count && i < sprite_count; i++)
+                {
+                    SDL_Rect rect = sprite_rects[i];
+                    rect.w *= 2;
+                    rect.h *= 2;
+                    Blitter::blit(frame, sprite, nullptr, rect);
+                }
+                Blitter::blit(frame, text, nullptr, text_rect);
+            });
+        }
+        Blitter::setKernel(best);
+
+        // The same frame split into tiles and drawn on more and more threads.
+        TileRasterizer rasterizer;
+        std::vector<int> thread_counts = { 1 };
+        for (int threads = 2; threads < SDL_GetCPUCount(); threads *= 2)
+        {
+            thread_counts.push_back(threads);
+        }
+        if (SDL_GetCPUCount() > 1)
+        {
+            thread_counts.push_back(SDL_GetCPUCount());
+        }
+        for (const auto& threads : thread_counts)
+        {
+            rasterizer.start(threads);
+            Benchmark::run("TileRasterizer frame", { { "sprites", sprite_count }, { "threads", threads } }, [&] {
+                rasterizer.add(level, &camera, screen, false);
+                for (const auto& rect : sprite_rects)
+                {
+                    rasterizer.add(sprite, nullptr, rect, false);
+                }
+                for (int i = 0; i < stretched_count && i < sprite_count; i++)
+                {
+                    SDL_Rect rect = sprite_rects[i];
+                    rect.w *= 2;
+                    rect.h *= 2;
+                    rasterizer.add(sprite, nullptr, rect, false);
+                }
+                rasterizer.add(text, nullptr, text_rect, false);
+                rasterizer.draw(frame);
+            });
+        }
+        rasterizer.stop();
+
+        // SDL's software renderer draws the same frame into a surface. Like the game's
+        // level texture, every texture is blended, even the level.
+        SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Renderer* software = SDL_CreateSoftwareRenderer(target);
+        if (software == nullptr)
+        {
+            LOG_WARNING("Couldn't create a software renderer: " << SDL_GetError());
+            SDL_FreeSurface(target);
+            return;
+        }
+        auto createTexture = [&](std::vector<Uint32>& pixels, const int width, const int height) {
+            SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(pixels.data(), width, height, 32, width * 4, SDL_PIXELFORMAT_ARGB8888);
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(software, surface);
+            SDL_FreeSurface(surface);
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            return texture;
+        };
+        SDL_Texture* level_texture = createTexture(level_pixels, size.x * 2, size.y * 2);
+        SDL_Texture* sprite_texture = createTexture(sprite_pixels, sprite_size, sprite_size);
+        SDL_Texture* text_texture = createTexture(text_pixels, text_size.x, text_size.y);
+
+        Benchmark::run("SDL software renderer frame", { { "sprites", sprite_count } }, [&] {
+            SDL_RenderCopy(software, level_texture, &camera, &screen);
+            for (const auto& rect : sprite_rects)
+            {
+                SDL_RenderCopy(software, sprite_texture, nullptr, &rect);
+            }
+            for (int i = 0; i < stretched_count && i < sprite_count; i++)
+            {
+                SDL_Rect rect = sprite_rects[i];
+                rect.w *= 2;
+                rect.h *= 2;
+                SDL_RenderCopy(software, sprite_texture, nullptr, &rect);
+            }
+            SDL_RenderCopy(software, text_texture, nullptr, &text_rect);
+            SDL_RenderFlush(software);
+        });
+
+        SDL_DestroyTexture(level_texture);
+        SDL_DestroyTexture(sprite_texture);
+        SDL_DestroyTexture(text_texture);
+        SDL_DestroyRenderer(software);
+        SDL_FreeSurface(target);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> sizes = { 64, 128, 256 };
+    std::vector<int> projectile_counts = { 100, 1000 };
+    int enemy_count = 16;
+    Uint64 seed = 1;
+    std::string out_file = "BenchmarkResults.json";
+
+    for (int i = 1; i < argc - 1; i += 2)
+    {
+        std::string option = argv[i];
+        std::string value = argv[i + 1];
+
+        if (option == "-sizes") sizes = parseList(value);
+        else if (option == "-enemies") enemy_count = atoi(value.c_str());
+        else if (option == "-projectiles") projectile_counts = parseList(value);
+        else if (option == "-seed") seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (option == "-time") Benchmark::setMinimumTime(atof(value.c_str()));
+        else if (option == "-out") out_file = value;
+        else
+        {
+            LOG_ERROR("Unknown option: " << option);
+            return 1;
+        }
+    }
+
+    try
+    {
+        // Textures and fonts need a renderer, so the game has to be started up.
+        Application::startUp("Benchmarks", 1024, 576, 1024, 576, false, 60);
+
+        for (const auto& size : sizes)
+        {
+            benchmarkLevel(size, enemy_count, projectile_counts, seed);
+        }
+        benchmarkTools(sizes);
+        for (const auto& sprite_count : { 64, 512 })
+        {
+            benchmarkBlitter(sprite_count);
+        }
+
+        std::ofstream out(out_file);
+        Benchmark::writeJson(out);
+        LOG_INFO("Results written to: " << out_file);
+
+        Application::shutDown();
+    }
+    catch (const Application::Error&)
+    {
+        LOG_ERROR("Error: " << SDL_GetError());
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "../LevelGenerator.h"
+
+#include <cmath>
+
+/**
+* This program writes generated levels for benchmarking. Build it together with
+* LevelGenerator.cpp, Random.cpp and Log.cpp.
+*
+* Usage:
+*   GenerateLevels -out <file> [-width N] [-height N] [-seed N] [-density F] [-rooms N]
+*                  [-guards N] [-soldiers N] [-officers N] [-ss N] [-pickups F]
+*   GenerateLevels -corpus <folder> [-seed N]
+*
+* The "-corpus" option writes square levels from 64x64 up to 2048x2048 into the folder,
+* with the number of rooms and enemies scaled by the area of the level.
+*/
+int main(int argc, char* argv[])
+{
+    LevelGenerator::Settings settings;
+    std::string out_file;
+    std::string corpus_folder;
+
+    for (int i = 1; i < argc - 1; i += 2)
+    {
+        std::string option = argv[i];
+        std::string value = argv[i + 1];
+
+        if (option == "-out") out_file = value;
+        else if (option == "-corpus") corpus_folder = value;
+        else if (option == "-width") settings.width = atoi(value.c_str());
+        else if (option == "-height") settings.height = atoi(value.c_str());
+        else if (option == "-seed") settings.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (option == "-density") settings.maze_density = static_cast<float>(atof(value.c_str()));
+        else if (option == "-rooms") settings.room_count = atoi(value.c_str());
+        else if (option == "-guards") settings.enemy_counts[0] = atoi(value.c_str());
+        else if (option == "-soldiers") settings.enemy_counts[1] = atoi(value.c_str());
+        else if (option == "-officers") settings.enemy_counts[2] = atoi(value.c_str());
+        else if (option == "-ss") settings.enemy_counts[3] = atoi(value.c_str());
+        else if (option == "-pickups") settings.pickup_density = static_cast<float>(atof(value.c_str()));
+        else
+        {
+            LOG_ERROR("Unknown option: " << option);
+            return 1;
+        }
+    }
+
+    try
+    {
+        if (!corpus_folder.empty())
+        {
+            // The default settings are for a 64x64 level, so everything is scaled from there.
+            LevelGenerator::Settings base = settings;
+            for (int size = 64; size <= 2048; size *= 2)
+            {
+                float scale = static_cast<float>(size * size) / (64 * 64);
+
+                settings.width = size;
+                settings.height = size;
+                settings.title = "Generated " + std::to_string(size) + "x" + std::to_string(size);
+                settings.room_count = static_cast<int>(std::round(base.room_count * scale));
+                for (int type = 0; type < 4; type++)
+                {
+                    settings.enemy_counts[type] = static_cast<int>(std::round(base.enemy_counts[type] * scale));
+                }
+
+                std::string file_name = corpus_folder + "/" + std::to_string(size) + ".xml";
+                LOG_INFO("Generating level: " << file_name);
+
+                LevelGenerator generator(settings);
+                generator.generate();
+                generator.save(file_name);
+            }
+        }
+        else if (!out_file.empty())
+        {
+            LOG_INFO("Generating level: " << out_file);
+
+            LevelGenerator generator(settings);
+            generator.generate();
+            generator.save(out_file);
+        }
+        else
+        {
+            LOG_ERROR("Either \"-out <file>\" or \"-corpus <folder>\" is needed.");
+            return 1;
+        }
+    }
+    catch (const Application::Error&)
+    {
+        LOG_ERROR("Error: " << SDL_GetError());
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+// This program doesn't use SDL itself, so SDL doesn't need to replace "main".
+#define SDL_MAIN_HANDLED
+#include "../Random.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+* This program compares the speed of the random number generators in the Random namespace
+* against the functions Tools used to have, which built a distribution for every call on a
+* hidden std::default_random_engine. Build it together with Random.cpp.
+*/
+namespace
+{
+    const int ITERATIONS = 10000000;
+    const int BATCH_SIZE = 1024;
+
+    /**
+    * These are the old random functions, kept here as the baseline.
+    */
+    float legacyRandomFloat(const float from, const float to)
+    {
+        static std::default_random_engine engine(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+        std::uniform_real_distribution<float> dist(from, to);
+        return dist(engine);
+    }
+
+    int legacyRandomInt(const int from, const int to)
+    {
+        static std::default_random_engine engine(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+        std::uniform_int_distribution<int> dist(from, to);
+        return dist(engine);
+    }
+
+    /**
+    * This function times "function", which should generate ITERATIONS numbers, and
+    * prints the time taken per number. The sum of the numbers is printed so that
+    * the compiler can't optimize the work away.
+    */
+    template <typename Function>
+    void benchmark(const std::string& name, Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto sum = function();
+        auto end = std::chrono::steady_clock::now();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+        std::cout << name << ": " << nanoseconds << " ns per number (checksum " << sum << ")" << std::endl;
+    }
+}
+
+int main()
+{
+    Random::seed(12345);
+    Random::Generator& generator = Random::getStream(Random::Stream::Simulation);
+
+    // These ranges match the ones the game uses: attack rolls and projectile spread.
+    benchmark("Legacy randomInt(0, 2)", [] {
+        Sint64 sum = 0;
+        for (int i = 0; i < ITERATIONS; i++) sum += legacyRandomInt(0, 2);
+        return sum;
+    });
+    benchmark("Generator::nextInt(0, 2)", [&] {
+        Sint64 sum = 0;
+        for (int i = 0; i < ITERATIONS; i++) sum += generator.nextInt(0, 2);
+        return sum;
+    });
+    benchmark("Legacy randomInt(-10, 10)", [] {
+        Sint64 sum = 0;
+        for (int i = 0; i < ITERATIONS; i++) sum += legacyRandomInt(-10, 10);
+        return sum;
+    });
+    benchmark("Generator::nextInt(-10, 10)", [&] {
+        Sint64 sum = 0;
+        for (int i = 0; i < ITERATIONS; i++) sum += generator.nextInt(-10, 10);
+        return sum;
+    });
+    benchmark("Generator::fillInts(-10, 10)", [&] {
+        Sint64 sum = 0;
+        std::vector<int> batch(BATCH_SIZE);
+        for (int i = 0; i < ITERATIONS; i += BATCH_SIZE)
+        {
+            generator.fillInts(batch.data(), batch.size(), -10, 10);
+            for (const auto& value : batch) sum += value;
+        }
+        return sum;
+    });
+    benchmark("Legacy randomFloat(0.5, 1.5)", [] {
+        double sum = 0.0;
+        for (int i = 0; i < ITERATIONS; i++) sum += legacyRandomFloat(0.5f, 1.5f);
+        return sum;
+    });
+    benchmark("Generator::nextFloat(0.5, 1.5)", [&] {
+        double sum = 0.0;
+        for (int i = 0; i < ITERATIONS; i++) sum += generator.nextFloat(0.5f, 1.5f);
+        return sum;
+    });
+    benchmark("Generator::fillFloats(0.5, 1.5)", [&] {
+        double sum = 0.0;
+        std::vector<float> batch(BATCH_SIZE);
+        for (int i = 0; i < ITERATIONS; i += BATCH_SIZE)
+        {
+            generator.fillFloats(batch.data(), batch.size(), 0.5f, 1.5f);
+            for (const auto& value : batch) sum += value;
+        }
+        return sum;
+    });
+    benchmark("Random::getThreadStream().nextInt(0, 2)", [] {
+        Sint64 sum = 0;
+        for (int i = 0; i < ITERATIONS; i++) sum += Random::getThreadStream().nextInt(0, 2);
+        return sum;
+    });
+
+    return 0;
+}
\ No newline at end of file
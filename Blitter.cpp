@@ -0,0 +1,386 @@
+#include "Blitter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BLITTER_X86
+#include <immintrin.h>
+#endif
+
+// GCC and Clang only allow SSE2 and AVX2 instructions in functions marked for them.
+// Visual Studio allows them anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/**
+* This namespace holds the loops that draw images onto each other on the CPU. Images
+* are 32 bit ARGB with the colours already multiplied by alpha, so blending a pixel is
+* just "source + destination * (255 - source alpha) / 255".
+*
+* The blend loop has a plain version and SSE2 and AVX2 versions, which blend 4 and 8
+* pixels at a time. The fastest one the CPU supports is picked at start up, and they
+* all give exactly the same result. Images with no transparent pixels are copied a row
+* at a time instead of being blended.
+*/
+namespace Blitter
+{
+    /**
+    * This anonymous namespace holds the blend loops, and the row that stretched
+    * images are gathered into before they're blended.
+    */
+    namespace
+    {
+        /**
+        * This function returns "value * scale / 255", rounded to the nearest whole number.
+        */
+        inline Uint32 multiply(const Uint32 value, const Uint32 scale)
+        {
+            Uint32 product = (value * scale) + 128;
+            return (product + (product >> 8)) >> 8;
+        }
+
+        /**
+        * This function blends one pixel onto another.
+        */
+        inline Uint32 blendPixel(const Uint32 source, const Uint32 destination)
+        {
+            Uint32 inverse_alpha = 255 - (source >> 24);
+            Uint32 result = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                Uint32 channel = ((source >> shift) & 0xFF) + multiply((destination >> shift) & 0xFF, inverse_alpha);
+                result |= std::min<Uint32>(channel, 255) << shift;
+            }
+            return result;
+        }
+
+        void blendScalar(Uint32* destination, const Uint32* source, const int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                destination[i] = blendPixel(source[i], destination[i]);
+            }
+        }
+
+#ifdef BLITTER_X86
+        /**
+        * This function blends 4 pixels. Each channel is widened to 16 bits so it can
+        * be multiplied by the inverse of its pixel's alpha, and then narrowed again.
+        */
+        TARGET_SSE2 inline __m128i blendSSE2(const __m128i source, const __m128i destination)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i maximum = _mm_set1_epi16(255);
+            const __m128i half = _mm_set1_epi16(128);
+
+            // Put each pixel's alpha in both 16 bit halves, and then in every channel
+            // of the pixel.
+            __m128i alpha = _mm_srli_epi32(source, 24);
+            alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+            __m128i inverse_low = _mm_sub_epi16(maximum, _mm_shuffle_epi32(alpha, _MM_SHUFFLE(1, 1, 0, 0)));
+            __m128i inverse_high = _mm_sub_epi16(maximum, _mm_shuffle_epi32(alpha, _MM_SHUFFLE(3, 3, 2, 2)));
+
+            __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero), inverse_low), half);
+            __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero), inverse_high), half);
+            low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+            high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+
+            return _mm_adds_epu8(source, _mm_packus_epi16(low, high));
+        }
+
+        TARGET_SSE2 void blendRowSSE2(Uint32* destination, const Uint32* source, const int count)
+        {
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i source_pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i destination_pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), blendSSE2(source_pixels, destination_pixels));
+            }
+            blendScalar(destination + i, source + i, count - i);
+        }
+
+        /**
+        * This function blends 8 pixels. It works the same way as the SSE2 version, on
+        * each half of the register.
+        */
+        TARGET_AVX2 void blendRowAVX2(Uint32* destination, const Uint32* source, const int count)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i maximum = _mm256_set1_epi16(255);
+            const __m256i half = _mm256_set1_epi16(128);
+
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256i source_pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                __m256i destination_pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+
+                __m256i alpha = _mm256_srli_epi32(source_pixels, 24);
+                alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+                __m256i inverse_low = _mm256_sub_epi16(maximum, _mm256_shuffle_epi32(alpha, _MM_SHUFFLE(1, 1, 0, 0)));
+                __m256i inverse_high = _mm256_sub_epi16(maximum, _mm256_shuffle_epi32(alpha, _MM_SHUFFLE(3, 3, 2, 2)));
+
+                __m256i low = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(destination_pixels, zero), inverse_low), half);
+                __m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(destination_pixels, zero), inverse_high), half);
+                low = _mm256_srli_epi16(_mm256_add_epi16(low, _mm256_srli_epi16(low, 8)), 8);
+                high = _mm256_srli_epi16(_mm256_add_epi16(high, _mm256_srli_epi16(high, 8)), 8);
+
+                __m256i result = _mm256_adds_epu8(source_pixels, _mm256_packus_epi16(low, high));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), result);
+            }
+            blendRowSSE2(destination + i, source + i, count - i);
+        }
+#endif
+
+        typedef void (*BlendRow)(Uint32*, const Uint32*, int);
+
+        /**
+        * This function returns the blend loop for a kernel.
+        */
+        BlendRow getBlendRow(const Kernel kernel)
+        {
+#ifdef BLITTER_X86
+            if (kernel == Kernel::SSE2)
+            {
+                return blendRowSSE2;
+            }
+            if (kernel == Kernel::AVX2)
+            {
+                return blendRowAVX2;
+            }
+#endif
+            return blendScalar;
+        }
+
+        // The blend loop is picked before anything can be drawn, so threads can
+        // draw without setting it up.
+        Kernel kernel = getBestKernel();
+        BlendRow blend_row = getBlendRow(kernel);
+
+        // Stretched rows are gathered here first, so they can go through the same
+        // blend loop as everything else. Each thread has its own.
+        thread_local std::vector<Uint32> row;
+
+        /**
+        * This function copies or blends a row of pixels, depending on whether the
+        * source has any transparent pixels.
+        */
+        inline void drawRow(Uint32* destination, const Uint32* source, const int count, const bool opaque)
+        {
+            if (opaque)
+            {
+                std::memcpy(destination, source, count * sizeof(Uint32));
+            }
+            else
+            {
+                blend_row(destination, source, count);
+            }
+        }
+
+        /**
+        * This function multiplies the colour channels of a pixel by its alpha.
+        */
+        inline Uint32 premultiply(const Uint32 pixel)
+        {
+            Uint32 alpha = pixel >> 24;
+            return (alpha << 24) | (multiply((pixel >> 16) & 0xFF, alpha) << 16) | (multiply((pixel >> 8) & 0xFF, alpha) << 8) | multiply(pixel & 0xFF, alpha);
+        }
+    }
+
+    /**
+    * This function sets the size of an image. The pixels aren't cleared.
+    */
+    void resize(Image& image, const int width, const int height)
+    {
+        image.width = width;
+        image.height = height;
+        image.pixels.resize(static_cast<std::size_t>(width) * height);
+    }
+
+    /**
+    * This function sets an image from pixels with alpha that hasn't been multiplied in.
+    * "pitch" is the number of bytes between rows.
+    */
+    void load(Image& image, const Uint32* pixels, const int width, const int height, const int pitch)
+    {
+        resize(image, width, height);
+        image.opaque = true;
+        load(image, pixels, { 0, 0, width, height }, pitch);
+    }
+
+    /**
+    * This function sets part of an image from pixels with alpha that hasn't been
+    * multiplied in.
+    */
+    void load(Image& image, const Uint32* pixels, const SDL_Rect& rect, const int pitch)
+    {
+        for (int y = 0; y < rect.h; y++)
+        {
+            const Uint32* source = reinterpret_cast<const Uint32*>(reinterpret_cast<const Uint8*>(pixels) + (y * pitch));
+            Uint32* destination = &image.pixels[(static_cast<std::size_t>(rect.y + y) * image.width) + rect.x];
+            for (int x = 0; x < rect.w; x++)
+            {
+                destination[x] = premultiply(source[x]);
+                image.opaque = image.opaque && (source[x] >> 24) == 255;
+            }
+        }
+    }
+
+    /**
+    * This function writes an image with its alpha divided back out, the way SDL
+    * expects it.
+    */
+    void unload(const Image& image, Uint32* pixels, const int pitch)
+    {
+        for (int y = 0; y < image.height; y++)
+        {
+            const Uint32* source = &image.pixels[static_cast<std::size_t>(y) * image.width];
+            Uint32* destination = reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(pixels) + (y * pitch));
+            for (int x = 0; x < image.width; x++)
+            {
+                Uint32 alpha = source[x] >> 24;
+                if (alpha == 0 || alpha == 255)
+                {
+                    destination[x] = alpha == 0 ? 0 : source[x];
+                    continue;
+                }
+
+                Uint32 pixel = alpha << 24;
+                for (int shift = 0; shift < 24; shift += 8)
+                {
+                    pixel |= std::min<Uint32>(((((source[x] >> shift) & 0xFF) * 255) + (alpha / 2)) / alpha, 255) << shift;
+                }
+                destination[x] = pixel;
+            }
+        }
+    }
+
+    /**
+    * This function sets every pixel of an image to a colour, which must already
+    * be multiplied by its alpha.
+    */
+    void fill(Image& image, const Uint32 colour)
+    {
+        std::fill(image.pixels.begin(), image.pixels.end(), colour);
+        image.opaque = (colour >> 24) == 255;
+    }
+
+    /**
+    * This function draws part of an image onto another. "source_rect" can be null to
+    * draw the whole image, and is stretched to "destination_rect" using the nearest
+    * pixel if the sizes are different. Anything outside the destination or "clip_rect"
+    * is clipped, and clipping never changes which source pixel a pixel comes from.
+    */
+    void blit(Image& destination, const Image& source, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const bool flip_horizontal, const SDL_Rect* clip_rect)
+    {
+        SDL_Rect from = source_rect != nullptr ? *source_rect : SDL_Rect{ 0, 0, source.width, source.height };
+        const SDL_Rect& to = destination_rect;
+        if (from.w <= 0 || from.h <= 0 || to.w <= 0 || to.h <= 0)
+        {
+            return;
+        }
+
+        SDL_Rect clip = clip_rect != nullptr ? *clip_rect : SDL_Rect{ 0, 0, destination.width, destination.height };
+        int left = std::max({ to.x, clip.x, 0 });
+        int top = std::max({ to.y, clip.y, 0 });
+        int right = std::min({ to.x + to.w, clip.x + clip.w, destination.width });
+        int bottom = std::min({ to.y + to.h, clip.y + clip.h, destination.height });
+        if (left >= right || top >= bottom)
+        {
+            return;
+        }
+        int width = right - left;
+
+        // Images drawn at their own size are drawn straight from their rows.
+        if (from.w == to.w && from.h == to.h && !flip_horizontal)
+        {
+            for (int y = top; y < bottom; y++)
+            {
+                const Uint32* source_row = &source.pixels[(static_cast<std::size_t>(from.y + y - to.y) * source.width) + from.x + left - to.x];
+                drawRow(&destination.pixels[(static_cast<std::size_t>(y) * destination.width) + left], source_row, width, source.opaque);
+            }
+            return;
+        }
+
+        // Everything else steps through the source in 16.16 fixed point, from the
+        // middle of each destination pixel.
+        Sint64 step_x = (static_cast<Sint64>(from.w) << 16) / to.w;
+        Sint64 step_y = (static_cast<Sint64>(from.h) << 16) / to.h;
+        Sint64 start_x = ((left - to.x) * step_x) + (step_x / 2);
+        row.resize(width);
+
+        for (int y = top; y < bottom; y++)
+        {
+            int source_y = from.y + static_cast<int>((((y - to.y) * step_y) + (step_y / 2)) >> 16);
+            const Uint32* source_row = &source.pixels[static_cast<std::size_t>(source_y) * source.width];
+
+            Sint64 position = start_x;
+            for (int x = 0; x < width; x++, position += step_x)
+            {
+                int offset = static_cast<int>(position >> 16);
+                row[x] = source_row[flip_horizontal ? from.x + from.w - 1 - offset : from.x + offset];
+            }
+            drawRow(&destination.pixels[(static_cast<std::size_t>(y) * destination.width) + left], row.data(), width, source.opaque);
+        }
+    }
+
+    /**
+    * This function picks which blend loop is used. It falls back to the best one the CPU
+    * supports if it doesn't support "kernel".
+    */
+    void setKernel(const Kernel kernel)
+    {
+        Kernel best = getBestKernel();
+        Blitter::kernel = static_cast<int>(kernel) <= static_cast<int>(best) ? kernel : best;
+        blend_row = getBlendRow(Blitter::kernel);
+    }
+
+    /**
+    * This function returns the blend loop being used.
+    */
+    Kernel getKernel()
+    {
+        return kernel;
+    }
+
+    /**
+    * This function returns the best blend loop the CPU supports.
+    */
+    Kernel getBestKernel()
+    {
+#ifdef BLITTER_X86
+        if (SDL_HasAVX2())
+        {
+            return Kernel::AVX2;
+        }
+        if (SDL_HasSSE2())
+        {
+            return Kernel::SSE2;
+        }
+#endif
+        return Kernel::Scalar;
+    }
+
+    /**
+    * This function returns the name of a blend loop.
+    */
+    const char* getKernelName(const Kernel kernel)
+    {
+        switch (kernel)
+        {
+        case Kernel::SSE2:
+            return "SSE2";
+        case Kernel::AVX2:
+            return "AVX2";
+        default:
+            return "Scalar";
+        }
+    }
+}
\ No newline at end of file
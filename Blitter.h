@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+/**
+* This namespace holds the loops that draw images onto each other on the CPU. Images
+* are 32 bit ARGB with the colours already multiplied by alpha, so blending a pixel is
+* just "source + destination * (255 - source alpha) / 255".
+*
+* The blend loop has a plain version and SSE2 and AVX2 versions, which blend 4 and 8
+* pixels at a time. The fastest one the CPU supports is picked at start up, and they
+* all give exactly the same result. Images with no transparent pixels are copied a row
+* at a time instead of being blended.
+*/
+namespace Blitter
+{
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+    * This struct holds an image. "opaque" is true if every pixel has full alpha.
+    */
+    struct Image
+    {
+        std::vector<Uint32> pixels;
+        int width = 0;
+        int height = 0;
+        bool opaque = false;
+    };
+
+    /**
+    * This function sets the size of an image. The pixels aren't cleared.
+    */
+    void resize(Image& image, const int width, const int height);
+
+    /**
+    * This function sets an image from pixels with alpha that hasn't been multiplied in.
+    * "pitch" is the number of bytes between rows.
+    */
+    void load(Image& image, const Uint32* pixels, const int width, const int height, const int pitch);
+
+    /**
+    * This function sets part of an image from pixels with alpha that hasn't been
+    * multiplied in.
+    */
+    void load(Image& image, const Uint32* pixels, const SDL_Rect& rect, const int pitch);
+
+    /**
+    * This function writes an image with its alpha divided back out, the way SDL
+    * expects it.
+    */
+    void unload(const Image& image, Uint32* pixels, const int pitch);
+
+    /**
+    * This function sets every pixel of an image to a colour, which must already
+    * be multiplied by its alpha.
+    */
+    void fill(Image& image, const Uint32 colour);
+
+    /**
+    * This function draws part of an image onto another. "source_rect" can be null to
+    * draw the whole image, and is stretched to "destination_rect" using the nearest
+    * pixel if the sizes are different. Anything outside the destination or "clip_rect"
+    * is clipped, and clipping never changes which source pixel a pixel comes from.
+    */
+    void blit(Image& destination, const Image& source, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const bool flip_horizontal = false, const SDL_Rect* clip_rect = nullptr);
+
+    /**
+    * This function picks which blend loop is used. It falls back to the best one the CPU
+    * supports if it doesn't support "kernel".
+    */
+    void setKernel(const Kernel kernel);
+
+    /**
+    * This function returns the blend loop being used.
+    */
+    Kernel getKernel();
+
+    /**
+    * This function returns the best blend loop the CPU supports.
+    */
+    Kernel getBestKernel();
+
+    /**
+    * This function returns the name of a blend loop.
+    */
+    const char* getKernelName(const Kernel kernel);
+}
\ No newline at end of file
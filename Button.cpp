@@ -12,22 +12,30 @@ void Button::draw()
     current_text->draw();
 }
 
-void Button::update()
+bool Button::update()
 {
     if (SDL_PointInRect(&Application::getMousePosition(), &current_text->getRect()) && !is_big)
     {
         Mix_PlayChannel(-1, hover_sound, 0);
         is_big = true;
         current_text = &big_text;
+        return true;
     }
     else if (!SDL_PointInRect(&Application::getMousePosition(), &current_text->getRect()) && is_big)
     {
         is_big = false;
         current_text = &small_text;
+        return true;
     }
+    return false;
 }
 
 bool Button::isBig()
 {
     return is_big;
+}
+
+const SDL_Rect& Button::getRect()
+{
+    return big_text.getRect();
 }
\ No newline at end of file
@@ -7,8 +7,9 @@ class Button
 public:
     Button(const std::string& font_name, const int font_size, const std::string& text, const int x, const int y, const bool centered, const SDL_Colour& colour, const int width = 0);
     void draw();
-    void update();
+    bool update();
     bool isBig();
+    const SDL_Rect& getRect();
 
 private:
     bool is_big;
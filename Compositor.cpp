@@ -0,0 +1,405 @@
+#include "Compositor.h"
+#include "RenderThread.h"
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+/**
+* This namespace draws the game on the CPU instead of through SDL's renderer. Every texture
+* that's loaded keeps a copy of its pixels here, and drawing a texture to the screen records
+* a draw of those pixels. When the frame is finished, the draws are split into tiles and
+* blended into the frame with the Blitter on several threads, and the frame is uploaded and
+* drawn with one copy. This is faster than SDL's own software renderer, which blends
+* everything on one thread with generic loops.
+*
+* Textures that have been drawn to by SDL, like the level and the rotated sprites, are read
+* back into here with "capture". Anything drawn to the screen that the compositor doesn't
+* have pixels for is drawn by SDL as normal. The frame so far is uploaded first, and a new
+* transparent frame is started on top of it, so everything is still drawn in order.
+*
+* The world can be drawn at a lower resolution than the screen, between "beginWorld" and
+* "endWorld", and is then stretched to cover the screen. Without the compositor, this is
+* done with a target texture instead.
+*/
+namespace Compositor
+{
+    /**
+    * This anonymous namespace holds the pixels of every texture, and the frame.
+    */
+    namespace
+    {
+        bool enabled = false;
+        std::unordered_map<SDL_Texture*, Blitter::Image> images;
+
+        // The first layer of a frame is opaque, so it's uploaded as it is. Layers after
+        // something was drawn by SDL are transparent, and are blended on top.
+        Blitter::Image frame;
+        TileRasterizer rasterizer;
+        SDL_Texture* frame_texture = nullptr;
+        bool first_layer = true;
+        bool pending = false;
+
+        // Pixels read back from textures go here first.
+        std::vector<Uint32> buffer;
+
+        // The world is drawn into the top left of "world", or of "world_texture" without
+        // the compositor, and "world_rect" is the part that's been drawn to.
+        Blitter::Image world;
+        SDL_Texture* world_texture = nullptr;
+        SDL_Rect world_rect = { 0, 0, 0, 0 };
+        float world_scale = 1.0f;
+        bool in_world = false;
+
+        /**
+        * This function scales a rect on the screen to where it is in the world. Rects
+        * that touch are still touching after they're scaled.
+        */
+        SDL_Rect scaleRect(const SDL_Rect& rect)
+        {
+            int left = static_cast<int>(std::floor(rect.x * world_scale));
+            int top = static_cast<int>(std::floor(rect.y * world_scale));
+            int right = static_cast<int>(std::floor((rect.x + rect.w) * world_scale));
+            int bottom = static_cast<int>(std::floor((rect.y + rect.h) * world_scale));
+            return { left, top, right - left, bottom - top };
+        }
+
+        /**
+        * This function draws the world's draws so far, and adds a draw that stretches
+        * it over the frame.
+        */
+        void drawWorld()
+        {
+            rasterizer.draw(world);
+            rasterizer.add(world, &world_rect, { 0, 0, frame.width, frame.height }, false);
+            pending = true;
+        }
+    }
+
+    /**
+    * This function sets when the compositor is used, and how many threads draw the
+    * frame. "Auto" only uses it with the software renderer, and a thread count of 0
+    * uses one thread per CPU core. It must be called after the renderer has been
+    * created and before any textures are loaded.
+    */
+    void setup(const Mode mode, const int thread_count)
+    {
+        RenderThread::call([&] {
+            clear();
+
+            SDL_RendererInfo info;
+            bool software = SDL_GetRendererInfo(Application::getRenderer(), &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE);
+            enabled = mode == Mode::On || (mode == Mode::Auto && software);
+            if (!enabled)
+            {
+                return;
+            }
+
+            const SDL_Point& size = Application::getRenderSize();
+            frame_texture = SDL_CreateTexture(Application::getRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, size.x, size.y);
+            if (frame_texture == nullptr)
+            {
+                LOG_WARNING("Couldn't create the compositor's frame: " << SDL_GetError());
+                enabled = false;
+                return;
+            }
+            Blitter::resize(frame, size.x, size.y);
+            rasterizer.start(thread_count);
+            LOG_INFO("Compositor on, using " << Blitter::getKernelName(Blitter::getKernel()) << " on " << rasterizer.getThreadCount() << " threads");
+        });
+    }
+
+    /**
+    * This function keeps a copy of the pixels a texture was made from.
+    */
+    void addImage(SDL_Texture* texture, SDL_Surface* surface)
+    {
+        if (!enabled || texture == nullptr || surface == nullptr)
+        {
+            return;
+        }
+
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (converted == nullptr)
+        {
+            return;
+        }
+        SDL_LockSurface(converted);
+        Blitter::load(images[texture], static_cast<const Uint32*>(converted->pixels), converted->w, converted->h, converted->pitch);
+        SDL_UnlockSurface(converted);
+        SDL_FreeSurface(converted);
+    }
+
+    /**
+    * This function reads back what has been drawn to a texture, which must be the
+    * render target. "rect" can be null to read back the whole texture.
+    */
+    void capture(SDL_Texture* texture, const SDL_Rect* rect)
+    {
+        if (!enabled)
+        {
+            return;
+        }
+
+        // The first capture of a texture always reads back the whole thing.
+        SDL_Rect bounds = { 0, 0, 0, 0 };
+        SDL_QueryTexture(texture, nullptr, nullptr, &bounds.w, &bounds.h);
+        SDL_Rect area = bounds;
+        auto image_it = images.find(texture);
+        if (image_it != images.end() && rect != nullptr && !SDL_IntersectRect(rect, &bounds, &area))
+        {
+            return;
+        }
+
+        buffer.resize(static_cast<std::size_t>(area.w) * area.h);
+        if (SDL_RenderReadPixels(Application::getRenderer(), &area, SDL_PIXELFORMAT_ARGB8888, buffer.data(), area.w * 4) != 0)
+        {
+            LOG_WARNING("Couldn't read back a texture: " << SDL_GetError());
+            return;
+        }
+
+        if (image_it == images.end())
+        {
+            Blitter::load(images[texture], buffer.data(), area.w, area.h, area.w * 4);
+        }
+        else
+        {
+            Blitter::load(image_it->second, buffer.data(), area, area.w * 4);
+        }
+    }
+
+    /**
+    * This function forgets the pixels of a texture. It must be called before a texture
+    * that was added is destroyed. Any draws of it that are waiting are done first.
+    */
+    void removeImage(SDL_Texture* texture)
+    {
+        if (!rasterizer.isEmpty() && images.find(texture) != images.end())
+        {
+            rasterizer.draw(in_world ? world : frame);
+        }
+        images.erase(texture);
+    }
+
+    /**
+    * This function forgets the pixels of every texture, and destroys the frame.
+    */
+    void clear()
+    {
+        RenderThread::call([&] {
+            rasterizer.stop();
+            images.clear();
+            if (frame_texture != nullptr)
+            {
+                SDL_DestroyTexture(frame_texture);
+                frame_texture = nullptr;
+            }
+            if (world_texture != nullptr)
+            {
+                SDL_DestroyTexture(world_texture);
+                world_texture = nullptr;
+            }
+        });
+    }
+
+    /**
+    * This function starts a new frame.
+    */
+    void beginFrame()
+    {
+        in_world = false;
+        if (!enabled)
+        {
+            return;
+        }
+
+        Blitter::fill(frame, 0xFF000000);
+        first_layer = true;
+        pending = false;
+    }
+
+    /**
+    * This function draws a texture, like "SDL_RenderCopyEx" without an angle.
+    */
+    void draw(SDL_Texture* texture, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const SDL_RendererFlip flip)
+    {
+        if (RenderThread::isRecording())
+        {
+            RenderThread::record(texture, source_rect, destination_rect, 0, flip, false);
+            return;
+        }
+
+        if (enabled && SDL_GetRenderTarget(Application::getRenderer()) == nullptr)
+        {
+            auto image_it = images.find(texture);
+            if (image_it != images.end())
+            {
+                rasterizer.add(image_it->second, source_rect, in_world ? scaleRect(destination_rect) : destination_rect, flip == SDL_FLIP_HORIZONTAL);
+                pending = true;
+                return;
+            }
+            flush();
+        }
+
+        SDL_RenderCopyEx(Application::getRenderer(), texture, source_rect, &destination_rect, 0, nullptr, flip);
+    }
+
+    /**
+    * This function starts drawing the world at a fraction of the render size. The world
+    * covers everything drawn before it, so it should be drawn first. A scale of 1 draws
+    * the world straight to the screen as normal.
+    */
+    void beginWorld(const float scale)
+    {
+        if (RenderThread::isRecording())
+        {
+            RenderThread::recordBeginWorld(scale);
+            return;
+        }
+
+        in_world = false;
+        if (scale >= 1.0f)
+        {
+            return;
+        }
+
+        const SDL_Point& size = Application::getRenderSize();
+        world_scale = scale;
+        world_rect = { 0, 0, static_cast<int>(std::ceil(size.x * scale)), static_cast<int>(std::ceil(size.y * scale)) };
+        if (enabled)
+        {
+            // The world's pixels must not change while a stretch of it is waiting to be drawn.
+            if (!rasterizer.isEmpty())
+            {
+                rasterizer.draw(frame);
+            }
+            if (world.width != frame.width || world.height != frame.height)
+            {
+                Blitter::resize(world, frame.width, frame.height);
+            }
+            Blitter::fill(world, 0xFF000000);
+            in_world = true;
+            return;
+        }
+
+        SDL_Renderer* renderer = Application::getRenderer();
+        if (world_texture == nullptr)
+        {
+            world_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+            if (world_texture == nullptr)
+            {
+                LOG_WARNING("Couldn't create the world texture: " << SDL_GetError());
+                return;
+            }
+            SDL_SetTextureBlendMode(world_texture, SDL_BLENDMODE_NONE);
+        }
+
+        // Setting a target resets the scale, and setting the screen again puts it back.
+        SDL_SetRenderTarget(renderer, world_texture);
+        SDL_RenderSetScale(renderer, scale, scale);
+        SDL_RenderClear(renderer);
+        in_world = true;
+    }
+
+    /**
+    * This function stretches the world to cover the screen. Anything drawn after
+    * this is drawn at the full render size.
+    */
+    void endWorld()
+    {
+        if (RenderThread::isRecording())
+        {
+            RenderThread::recordEndWorld();
+            return;
+        }
+
+        if (!in_world)
+        {
+            return;
+        }
+
+        in_world = false;
+        if (enabled)
+        {
+            drawWorld();
+        }
+        else
+        {
+            SDL_SetRenderTarget(Application::getRenderer(), nullptr);
+            SDL_RenderCopy(Application::getRenderer(), world_texture, &world_rect, nullptr);
+        }
+    }
+
+    /**
+    * This function draws the frame so far to the screen. It must be called before
+    * drawing to the screen with SDL directly.
+    */
+    void flush()
+    {
+        if (!enabled || SDL_GetRenderTarget(Application::getRenderer()) != nullptr)
+        {
+            return;
+        }
+
+        // The world drawn so far goes under whatever SDL draws, and the rest of the
+        // world is drawn on top of it.
+        if (in_world)
+        {
+            drawWorld();
+        }
+
+        if (pending)
+        {
+            rasterizer.draw(frame);
+
+            void* pixels;
+            int pitch;
+            if (SDL_LockTexture(frame_texture, nullptr, &pixels, &pitch) == 0)
+            {
+                if (first_layer)
+                {
+                    // Every pixel of the first layer has full alpha, so multiplying by
+                    // alpha didn't change anything.
+                    for (int y = 0; y < frame.height; y++)
+                    {
+                        std::memcpy(static_cast<Uint8*>(pixels) + (y * pitch), &frame.pixels[static_cast<std::size_t>(y) * frame.width], frame.width * 4);
+                    }
+                }
+                else
+                {
+                    Blitter::unload(frame, static_cast<Uint32*>(pixels), pitch);
+                }
+                SDL_UnlockTexture(frame_texture);
+            }
+            SDL_SetTextureBlendMode(frame_texture, first_layer ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+            SDL_RenderCopy(Application::getRenderer(), frame_texture, nullptr, nullptr);
+        }
+
+        if (pending || first_layer)
+        {
+            Blitter::fill(frame, 0);
+        }
+        if (in_world)
+        {
+            Blitter::fill(world, 0);
+        }
+        first_layer = false;
+        pending = false;
+    }
+
+    /**
+    * This function draws the rest of the frame to the screen.
+    */
+    void endFrame()
+    {
+        flush();
+    }
+
+    /**
+    * This function returns whether the compositor is being used.
+    */
+    bool isEnabled()
+    {
+        return enabled;
+    }
+}
\ No newline at end of file
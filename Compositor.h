@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Application.h"
+#include "TileRasterizer.h"
+
+/**
+* This namespace draws the game on the CPU instead of through SDL's renderer. Every texture
+* that's loaded keeps a copy of its pixels here, and drawing a texture to the screen records
+* a draw of those pixels. When the frame is finished, the draws are split into tiles and
+* blended into the frame with the Blitter on several threads, and the frame is uploaded and
+* drawn with one copy. This is faster than SDL's own software renderer, which blends
+* everything on one thread with generic loops.
+*
+* Textures that have been drawn to by SDL, like the level and the rotated sprites, are read
+* back into here with "capture". Anything drawn to the screen that the compositor doesn't
+* have pixels for is drawn by SDL as normal. The frame so far is uploaded first, and a new
+* transparent frame is started on top of it, so everything is still drawn in order.
+*
+* The world can be drawn at a lower resolution than the screen, between "beginWorld" and
+* "endWorld", and is then stretched to cover the screen. Without the compositor, this is
+* done with a target texture instead.
+*/
+namespace Compositor
+{
+    enum class Mode
+    {
+        Auto,
+        On,
+        Off
+    };
+
+    /**
+    * This function sets when the compositor is used, and how many threads draw the
+    * frame. "Auto" only uses it with the software renderer, and a thread count of 0
+    * uses one thread per CPU core. It must be called after the renderer has been
+    * created and before any textures are loaded.
+    */
+    void setup(const Mode mode, const int thread_count);
+
+    /**
+    * This function keeps a copy of the pixels a texture was made from.
+    */
+    void addImage(SDL_Texture* texture, SDL_Surface* surface);
+
+    /**
+    * This function reads back what has been drawn to a texture, which must be the
+    * render target. "rect" can be null to read back the whole texture.
+    */
+    void capture(SDL_Texture* texture, const SDL_Rect* rect = nullptr);
+
+    /**
+    * This function forgets the pixels of a texture. It must be called before a texture
+    * that was added is destroyed. Any draws of it that are waiting are done first.
+    */
+    void removeImage(SDL_Texture* texture);
+
+    /**
+    * This function forgets the pixels of every texture, and destroys the frame.
+    */
+    void clear();
+
+    /**
+    * This function starts a new frame.
+    */
+    void beginFrame();
+
+    /**
+    * This function draws a texture, like "SDL_RenderCopyEx" without an angle.
+    */
+    void draw(SDL_Texture* texture, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+    /**
+    * This function starts drawing the world at a fraction of the render size. The world
+    * covers everything drawn before it, so it should be drawn first. A scale of 1 draws
+    * the world straight to the screen as normal.
+    */
+    void beginWorld(const float scale);
+
+    /**
+    * This function stretches the world to cover the screen. Anything drawn after
+    * this is drawn at the full render size.
+    */
+    void endWorld();
+
+    /**
+    * This function draws the frame so far to the screen. It must be called before
+    * drawing to the screen with SDL directly.
+    */
+    void flush();
+
+    /**
+    * This function draws the rest of the frame to the screen.
+    */
+    void endFrame();
+
+    /**
+    * This function returns whether the compositor is being used.
+    */
+    bool isEnabled();
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "DynamicResolution.h"
+#include "RenderThread.h"
+#include "Compositor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+/**
+* This namespace picks the resolution the world is drawn at, so the time spent drawing a
+* frame stays under a target. The world is drawn at a fraction of the render size and
+* stretched to fill the screen, and the HUD is always drawn at the full render size.
+*
+* The resolution only drops once drawing has been over the target for a while, and only
+* rises once it has been well under the target for longer, so it doesn't keep flipping
+* between two scales. After every change it waits before changing again.
+*/
+namespace DynamicResolution
+{
+    /**
+    * This anonymous namespace holds the average draw time and how long it has been
+    * over or under the target. The scale is read by the game thread while the render
+    * thread changes it.
+    */
+    namespace
+    {
+        const float AVERAGE_WEIGHT = 0.1f;
+        const float RAISE_FRACTION = 0.7f;
+        const int LOWER_FRAMES = 10;
+        const int RAISE_FRAMES = 60;
+        const int COOLDOWN_FRAMES = 30;
+
+        bool enabled = false;
+        float target = DEFAULT_TARGET_TIME;
+        std::atomic<float> scale(1.0f);
+        std::atomic<float> average_time(0.0f);
+        int over_frames = 0;
+        int under_frames = 0;
+        int cooldown = 0;
+
+        /**
+        * This function changes the scale by a step, and starts the cooldown.
+        */
+        void changeScale(const float step)
+        {
+            // The scale is kept to whole steps, so adding steps up doesn't drift.
+            float new_scale = std::round((scale + step) / SCALE_STEP) * SCALE_STEP;
+            new_scale = std::max(MINIMUM_SCALE, std::min(1.0f, new_scale));
+            over_frames = 0;
+            under_frames = 0;
+            cooldown = COOLDOWN_FRAMES;
+            if (new_scale != scale)
+            {
+                scale = new_scale;
+                LOG_INFO("Render scale " << static_cast<int>((new_scale * 100.0f) + 0.5f) << "%, drawing took " << (average_time * 1000.0f) << "ms");
+            }
+        }
+    }
+
+    /**
+    * This function sets when the resolution changes, and the time drawing a frame should
+    * take. "Auto" only changes it with the software renderer or the compositor. It must be
+    * called after the renderer has been created.
+    */
+    void setup(const Mode mode, const float target_time)
+    {
+        bool software = false;
+        RenderThread::call([&] {
+            SDL_RendererInfo info;
+            software = SDL_GetRendererInfo(Application::getRenderer(), &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE);
+        });
+
+        enabled = mode == Mode::On || (mode == Mode::Auto && (software || Compositor::isEnabled()));
+        target = target_time;
+        scale = 1.0f;
+        if (enabled)
+        {
+            LOG_INFO("Dynamic resolution on, aiming for " << (target * 1000.0f) << "ms");
+        }
+    }
+
+    /**
+    * This function is given how long each frame took to draw, and changes the scale
+    * if it needs to.
+    */
+    void addFrameTime(const float draw_time)
+    {
+        if (!enabled)
+        {
+            return;
+        }
+
+        average_time = average_time + ((draw_time - average_time) * AVERAGE_WEIGHT);
+        if (cooldown > 0)
+        {
+            cooldown--;
+            return;
+        }
+
+        over_frames = average_time > target ? over_frames + 1 : 0;
+        under_frames = average_time < target * RAISE_FRACTION ? under_frames + 1 : 0;
+        if (over_frames >= LOWER_FRAMES)
+        {
+            changeScale(-SCALE_STEP);
+        }
+        else if (under_frames >= RAISE_FRAMES)
+        {
+            changeScale(SCALE_STEP);
+        }
+    }
+
+    /**
+    * This function returns the fraction of the render size the world is drawn at.
+    */
+    float getScale()
+    {
+        return scale;
+    }
+
+    /**
+    * This function returns the average time a frame has taken to draw recently.
+    */
+    float getAverageTime()
+    {
+        return average_time;
+    }
+}
\ No newline at end of file
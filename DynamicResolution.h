@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This namespace picks the resolution the world is drawn at, so the time spent drawing a
+* frame stays under a target. The world is drawn at a fraction of the render size and
+* stretched to fill the screen, and the HUD is always drawn at the full render size.
+*
+* The resolution only drops once drawing has been over the target for a while, and only
+* rises once it has been well under the target for longer, so it doesn't keep flipping
+* between two scales. After every change it waits before changing again.
+*/
+namespace DynamicResolution
+{
+    enum class Mode
+    {
+        Auto,
+        On,
+        Off
+    };
+
+    /**
+    * This function sets when the resolution changes, and the time drawing a frame should
+    * take. "Auto" only changes it with the software renderer or the compositor. It must be
+    * called after the renderer has been created.
+    */
+    void setup(const Mode mode, const float target_time);
+
+    /**
+    * This function is given how long each frame took to draw, and changes the scale
+    * if it needs to.
+    */
+    void addFrameTime(const float draw_time);
+
+    /**
+    * This function returns the fraction of the render size the world is drawn at.
+    */
+    float getScale();
+
+    /**
+    * This function returns the average time a frame has taken to draw recently.
+    */
+    float getAverageTime();
+
+    const float MINIMUM_SCALE = 0.5f;
+    const float SCALE_STEP = 0.1f;
+    const float DEFAULT_TARGET_TIME = 0.01f;
+}
\ No newline at end of file
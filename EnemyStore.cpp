@@ -0,0 +1,751 @@
+#include "EnemyStore.h"
+
+#include <algorithm>
+
+/**
+* This method adds an enemy in the middle of a tile, and returns its handle.
+*/
+EnemyStore::Handle EnemyStore::spawn(const EnemyType type, const SDL_Rect& tile_rect)
+{
+    const EnemyTypeData& data = ENEMY_TYPES[static_cast<int>(type)];
+    int type_index = static_cast<int>(type);
+    if (textures[type_index] == nullptr)
+    {
+        textures[type_index] = Application::getTexture(data.texture);
+        dead_textures[type_index] = Application::getTexture(data.dead_texture);
+    }
+    if (shout == nullptr)
+    {
+        shout = Application::getSound("Resources/Sounds/Shout.wav");
+    }
+
+    SDL_Rect rect;
+    SDL_QueryTexture(textures[type_index], nullptr, nullptr, &rect.w, &rect.h);
+    rect.x = (tile_rect.x + (tile_rect.w / 2)) - rect.w / 2;
+    rect.y = (tile_rect.y + (tile_rect.h / 2)) - rect.h / 2;
+
+    // This gives the enemy some individuality. It means that all enemies won't
+    // change direction at the same time.
+    Pathing pathing;
+    pathing.ai_time = Tools::randomFloat(AI_TIME_MINIUM, AI_TIME_MAXIMUM);
+    pathing.node_rect = { 0, 0, NODE_SIZE, NODE_SIZE };
+
+    Patrol patrol;
+    patrol.home_tile = { tile_rect.x / Level::TILE_SIZE, tile_rect.y / Level::TILE_SIZE };
+
+    // Reuse a free slot if there is one.
+    Handle handle;
+    if (free_slots.empty())
+    {
+        handle.slot = static_cast<Uint32>(slot_indices.size());
+        slot_indices.push_back(NO_INDEX);
+        slot_generations.push_back(0);
+    }
+    else
+    {
+        handle.slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    handle.generation = slot_generations[handle.slot];
+    slot_indices[handle.slot] = static_cast<Uint32>(rects.size());
+
+    rects.push_back(rect);
+    angles.push_back(0);
+    movements.push_back({ 0.0, 0.0 });
+    healths.push_back(data.health);
+    types.push_back(type);
+    attacks.emplace_back();
+    pathings.push_back(pathing);
+    patrols.push_back(patrol);
+    paths.emplace_back();
+
+    // Stagger the updates of enemies that aren't updated every frame.
+    Schedule schedule;
+    schedule.countdown = static_cast<int>(rects.size() % FAR_INTERVAL);
+    schedules.push_back(schedule);
+    slots.push_back(handle.slot);
+
+    // The behaviour starts straight away, so everything else has to be added first.
+    behaviours.emplace_back();
+    behaviours.back().movement = patrolBehaviour(handle);
+
+    return handle;
+}
+
+/**
+* This method removes the enemy at an index. The last enemy is moved into its place.
+*/
+void EnemyStore::remove(const std::size_t index)
+{
+    // Alerted enemies have to stay at the front, so an alerted enemy is first swapped
+    // with the last alerted enemy.
+    std::size_t current = index;
+    if (current < alerted_count)
+    {
+        alerted_count--;
+        swap(current, alerted_count);
+        current = alerted_count;
+    }
+    swap(current, rects.size() - 1);
+
+    Uint32 slot = slots.back();
+    slot_indices[slot] = NO_INDEX;
+    slot_generations[slot]++;
+    free_slots.push_back(slot);
+
+    rects.pop_back();
+    angles.pop_back();
+    movements.pop_back();
+    healths.pop_back();
+    types.pop_back();
+    attacks.pop_back();
+    pathings.pop_back();
+    patrols.pop_back();
+    paths.pop_back();
+    schedules.pop_back();
+    slots.pop_back();
+    behaviours.pop_back();
+}
+
+/**
+* This method removes every enemy.
+*/
+void EnemyStore::clear()
+{
+    while (!rects.empty())
+    {
+        remove(rects.size() - 1);
+    }
+}
+
+/**
+* This method returns the number of enemies.
+*/
+std::size_t EnemyStore::size()
+{
+    return rects.size();
+}
+
+/**
+* This method returns the index of the enemy a handle refers to, or -1 if the
+* enemy has been removed.
+*/
+int EnemyStore::find(const Handle& handle)
+{
+    if (handle.slot >= slot_indices.size() || slot_generations[handle.slot] != handle.generation || slot_indices[handle.slot] == NO_INDEX)
+    {
+        return -1;
+    }
+    return static_cast<int>(slot_indices[handle.slot]);
+}
+
+/**
+* This method returns the handle of the enemy at an index.
+*/
+EnemyStore::Handle EnemyStore::getHandle(const std::size_t index)
+{
+    return { slots[index], slot_generations[slots[index]] };
+}
+
+/**
+* This method updates every enemy. Alerted enemies follow their paths to the player
+* and shoot, and the rest look out for the player.
+*/
+void EnemyStore::update(Level& level, Player& player, std::vector<Projectile>& enemy_projectiles)
+{
+    budget_left = AI_BUDGET;
+    over_budget = false;
+    updated_count = 0;
+    updateSchedules(player);
+
+    // Resume every behaviour that's due. Behaviours only run here, so they can use
+    // the projectiles and navigation version for this frame.
+    projectiles = &enemy_projectiles;
+    navigation_version = level.getNavigationVersion();
+    wheel.advance(Application::getDeltaTime());
+
+    // Next frame starts from the first enemy that missed out, or from the next enemy
+    // along if none did. Enemies alerted this frame start chasing the player next frame.
+    std::size_t next_cursor = alerted_cursor + 1;
+    bool missed_out = false;
+    for (std::size_t n = 0; n < alerted_count; n++)
+    {
+        std::size_t i = (alerted_cursor + n) % alerted_count;
+        if (shouldUpdate(i))
+        {
+            float delta_time = schedules[i].elapsed;
+            schedules[i].elapsed = 0.0;
+            updatePath(i, level, player);
+            updateMovement(i, level, player, delta_time);
+        }
+        else if (over_budget && !missed_out)
+        {
+            next_cursor = i;
+            missed_out = true;
+        }
+    }
+    alerted_cursor = alerted_count > 0 ? next_cursor % alerted_count : 0;
+
+    // Enemies that spot the player are moved to the front once every enemy has looked,
+    // so that the loop doesn't skip any.
+    std::size_t unalerted_count = rects.size() - alerted_count;
+    next_cursor = unalerted_cursor + 1;
+    missed_out = false;
+    spotted.clear();
+    for (std::size_t n = 0; n < unalerted_count; n++)
+    {
+        std::size_t offset = (unalerted_cursor + n) % unalerted_count;
+        std::size_t i = alerted_count + offset;
+        if (shouldUpdate(i))
+        {
+            float delta_time = schedules[i].elapsed;
+            schedules[i].elapsed = 0.0;
+            if (canSeePlayer(i, level, player))
+            {
+                spotted.push_back(i);
+            }
+            else
+            {
+                updatePatrol(i, level);
+                updateMovement(i, level, player, delta_time);
+            }
+        }
+        else if (over_budget && !missed_out)
+        {
+            next_cursor = offset;
+            missed_out = true;
+        }
+    }
+    unalerted_cursor = unalerted_count > 0 ? next_cursor % unalerted_count : 0;
+
+    // Moving the enemies in order means an enemy that's still to be moved is never
+    // swapped out of the way.
+    std::sort(spotted.begin(), spotted.end());
+    for (const auto& i : spotted)
+    {
+        Mix_PlayChannel(-1, shout, 0);
+        paths[i].clear();
+        movements[i] = { 0.0, 0.0 };
+        swap(i, alerted_count);
+        behaviours[alerted_count].movement = chaseBehaviour(getHandle(alerted_count), level.getNavigationEvent());
+        behaviours[alerted_count].attack = attackBehaviour(getHandle(alerted_count));
+        alerted_count++;
+    }
+}
+
+/**
+* This method sends every enemy that hasn't been alerted and is within "distance"
+* of a noise to where the noise came from.
+*/
+void EnemyStore::investigate(Level& level, const SDL_Point& position, const int distance)
+{
+    SDL_Point noise_tile = { position.x / Level::TILE_SIZE, position.y / Level::TILE_SIZE };
+    for (std::size_t i = alerted_count; i < rects.size(); i++)
+    {
+        SDL_Point centre = { rects[i].x + (rects[i].w / 2), rects[i].y + (rects[i].h / 2) };
+        Sint64 dx = centre.x - position.x;
+        Sint64 dy = centre.y - position.y;
+        if ((dx * dx) + (dy * dy) > static_cast<Sint64>(distance) * distance)
+        {
+            continue;
+        }
+
+        SDL_Point tile = { centre.x / Level::TILE_SIZE, centre.y / Level::TILE_SIZE };
+        if (level.findPath(tile, noise_tile, paths[i]))
+        {
+            startPath(i, level);
+            patrols[i].investigating = true;
+            patrols[i].move_on = false;
+        }
+    }
+}
+
+/**
+* This method draws every enemy to the screen.
+*/
+void EnemyStore::draw()
+{
+    for (std::size_t i = 0; i < rects.size(); i++)
+    {
+        SDL_Rect draw_rect = Application::applyCamera(rects[i]);
+        SpriteCache::draw(textures[static_cast<int>(types[i])], draw_rect, angles[i]);
+    }
+}
+
+/**
+* This method damages the enemy at an index.
+*/
+void EnemyStore::damage(const std::size_t index, const int damage)
+{
+    healths[index] -= damage;
+}
+
+/**
+* This method determines if the enemy at an index is dead and should be
+* removed from the game or not.
+*/
+bool EnemyStore::isDead(const std::size_t index)
+{
+    return healths[index] <= 0;
+}
+
+/**
+* This method returns the rects of every enemy, in index order.
+*/
+const std::vector<SDL_Rect>& EnemyStore::getRects()
+{
+    return rects;
+}
+
+/**
+* This method returns the angle of the enemy at an index.
+*/
+int EnemyStore::getAngle(const std::size_t index)
+{
+    return angles[index];
+}
+
+/**
+* This method returns the health of the enemy at an index.
+*/
+int EnemyStore::getHealth(const std::size_t index)
+{
+    return healths[index];
+}
+
+/**
+* This method returns the texture of the enemy at an index for when it dies.
+*/
+SDL_Texture* EnemyStore::getDeadTexture(const std::size_t index)
+{
+    return dead_textures[static_cast<int>(types[index])];
+}
+
+/**
+* This method returns the weapon that the enemy at an index uses.
+*/
+const Weapon& EnemyStore::getWeapon(const std::size_t index)
+{
+    return ENEMY_TYPES[static_cast<int>(types[index])].weapon;
+}
+
+/**
+* This method returns how many enemies were updated last frame.
+*/
+std::size_t EnemyStore::getUpdatedCount()
+{
+    return updated_count;
+}
+
+/**
+* This method decides how often each enemy should be updated, and which enemies
+* are due an update this frame.
+*/
+void EnemyStore::updateSchedules(Player& player)
+{
+    SDL_Point player_centre = player.getCentre();
+    for (std::size_t i = 0; i < rects.size(); i++)
+    {
+        Schedule& schedule = schedules[i];
+        int dx = (rects[i].x + (rects[i].w / 2)) - player_centre.x;
+        int dy = (rects[i].y + (rects[i].h / 2)) - player_centre.y;
+        Sint64 distance = (static_cast<Sint64>(dx) * dx) + (static_cast<Sint64>(dy) * dy);
+
+        // Enemies that are far away only need to be updated if they're chasing the player.
+        if (distance <= static_cast<Sint64>(NEAR_DISTANCE) * NEAR_DISTANCE)
+        {
+            schedule.interval = 1;
+        }
+        else if (distance <= static_cast<Sint64>(FAR_DISTANCE) * FAR_DISTANCE)
+        {
+            schedule.interval = MIDDLE_INTERVAL;
+        }
+        else
+        {
+            schedule.interval = i < alerted_count ? FAR_INTERVAL : 0;
+        }
+
+        schedule.countdown = std::max(0, std::min(schedule.countdown - 1, schedule.interval));
+        schedule.elapsed = std::min(schedule.elapsed + Application::getDeltaTime(), MAXIMUM_ELAPSED);
+    }
+}
+
+/**
+* This method determines if a due enemy should be updated now. Enemies close to the
+* player always are, and the rest are only updated while the AI budget lasts.
+*/
+bool EnemyStore::shouldUpdate(const std::size_t index)
+{
+    Schedule& schedule = schedules[index];
+    if (schedule.interval == 0 || schedule.countdown > 0)
+    {
+        return false;
+    }
+
+    // The budget counts updates instead of timing them, so which enemies are updated
+    // doesn't depend on how fast the computer is.
+    if (schedule.interval > 1)
+    {
+        if (budget_left == 0)
+        {
+            over_budget = true;
+            return false;
+        }
+        budget_left--;
+    }
+
+    schedule.countdown = schedule.interval;
+    updated_count++;
+    return true;
+}
+
+/**
+* This method moves an alerted enemy along its path, and turns it towards
+* the player if it can see them.
+*/
+void EnemyStore::updatePath(const std::size_t index, Level& level, Player& player)
+{
+    SDL_Rect& rect = rects[index];
+    Pathing& pathing = pathings[index];
+    std::deque<SDL_Point>& path = paths[index];
+    SDL_Point centre = { rect.x + (rect.w / 2), rect.y + (rect.h / 2) };
+
+    // The path to the player has to be updated when the player moves, otherwise the
+    // enemy will move to the player's old position.
+    if (pathing.replan || path.empty())
+    {
+        pathing.replan = false;
+        pathing.navigation_version = level.getNavigationVersion();
+        SDL_Point tile = { centre.x / level.TILE_SIZE, centre.y / level.TILE_SIZE };
+        path.clear();
+        if (level.hasPathToTile(tile))
+        {
+            path = level.getPathToTile(tile);
+            startPath(index, level);
+        }
+    }
+
+    if (!followPath(index, static_cast<float>(ENEMY_TYPES[static_cast<int>(types[index])].speed)))
+    {
+        return;
+    }
+
+    // Make the enemy face the player if it can see them.
+    attacks[index].facing_player = level.isInLineOfSight(centre, player.getCentre());
+    if (attacks[index].facing_player)
+    {
+        angles[index] = Tools::angleBetweenPoints(
+            centre.x,
+            centre.y,
+            player.getCentre().x,
+            player.getCentre().y
+        ) - 180;
+    }
+}
+
+/**
+* This method moves an enemy that hasn't been alerted along its patrol, or to
+* whatever it's investigating. When its patrol behaviour says so, it picks a new
+* tile near where it started.
+*/
+void EnemyStore::updatePatrol(const std::size_t index, Level& level)
+{
+    Patrol& patrol = patrols[index];
+    std::deque<SDL_Point>& path = paths[index];
+    float speed = static_cast<float>(ENEMY_TYPES[static_cast<int>(types[index])].speed);
+    if (followPath(index, patrol.investigating ? speed : speed * PATROL_SPEED))
+    {
+        return;
+    }
+
+    if (!patrol.move_on)
+    {
+        return;
+    }
+    patrol.move_on = false;
+    patrol.investigating = false;
+
+    // Not every tile near home is a floor tile, so a few are tried.
+    SDL_Point tile = { (rects[index].x + (rects[index].w / 2)) / Level::TILE_SIZE, (rects[index].y + (rects[index].h / 2)) / Level::TILE_SIZE };
+    for (int attempt = 0; attempt < PATROL_ATTEMPTS; attempt++)
+    {
+        SDL_Point destination = {
+            patrol.home_tile.x + Tools::randomInt(-PATROL_RADIUS, PATROL_RADIUS),
+            patrol.home_tile.y + Tools::randomInt(-PATROL_RADIUS, PATROL_RADIUS)
+        };
+        if (level.findPath(tile, destination, path))
+        {
+            startPath(index, level);
+            break;
+        }
+    }
+}
+
+/**
+* This method moves an enemy towards the next node in its path at a speed, and
+* returns false if it has reached the end of the path.
+*/
+bool EnemyStore::followPath(const std::size_t index, const float speed)
+{
+    SDL_Rect& rect = rects[index];
+    std::deque<SDL_Point>& path = paths[index];
+    SDL_Point centre = { rect.x + (rect.w / 2), rect.y + (rect.h / 2) };
+
+    // Check if the enemy's centre is in the path node.
+    if (!path.empty() && SDL_PointInRect(&centre, &pathings[index].node_rect))
+    {
+        // If it is, we need to move to the next path node.
+        path.pop_back();
+        setNextNode(index);
+    }
+
+    // If the path is empty, stop moving.
+    if (path.empty())
+    {
+        patrols[index].path_finished.signal();
+        movements[index] = { 0.0, 0.0 };
+        return false;
+    }
+
+    // This makes sure the enemy faces and moves towards the next node in the path.
+    const SDL_Rect& node_rect = pathings[index].node_rect;
+    angles[index] = Tools::angleBetweenPoints(
+        centre.x,
+        centre.y,
+        (node_rect.x + (node_rect.w / 2)),
+        (node_rect.y + (node_rect.h / 2))
+    ) - 180;
+
+    // Set the movement vector so that it moves towards the next node in the path.
+    Tools::FloatVector movement;
+    movement.x = static_cast<float>(std::cos(angles[index] * 0.0174533));
+    movement.y = static_cast<float>(std::sin(angles[index] * 0.0174533));
+    movement = Tools::normalizeVector(movement);
+    movements[index] = { movement.x * speed, movement.y * speed };
+    return true;
+}
+
+/**
+* This method moves an enemy and handles its collisions.
+*/
+void EnemyStore::updateMovement(const std::size_t index, Level& level, Player& player, const float delta_time)
+{
+    SDL_Rect& rect = rects[index];
+    const Tools::FloatVector& movement = movements[index];
+
+    // Create a vector of solids. Enemies don't collide with themselves.
+    std::vector<SDL_Rect> solids = level.getSurroundingSolids((rect.x + (rect.w / 2)) / level.TILE_SIZE, (rect.y + (rect.h / 2)) / level.TILE_SIZE);
+    solids.push_back(player.getRect());
+    solids.insert(solids.end(), rects.begin(), rects.begin() + index);
+    solids.insert(solids.end(), rects.begin() + index + 1, rects.end());
+
+    // Movement and collisions on the X axis.
+    rect.x += static_cast<int>(std::round(movement.x * delta_time));
+    for (const auto& solid : solids)
+    {
+        if (SDL_HasIntersection(&rect, &solid))
+        {
+            if (static_cast<int>(movement.x) > 0)
+            {
+                rect.x = solid.x - rect.w;
+            }
+            else if (static_cast<int>(movement.x) < 0)
+            {
+                rect.x = solid.x + solid.w;
+            }
+        }
+    }
+
+    // Movement and collisions on the Y axis.
+    rect.y += static_cast<int>(std::round(movement.y * delta_time));
+    for (const auto& solid : solids)
+    {
+        if (SDL_HasIntersection(&rect, &solid))
+        {
+            if (static_cast<int>(movement.y) > 0)
+            {
+                rect.y = solid.y - rect.h;
+            }
+            else if (static_cast<int>(movement.y) < 0)
+            {
+                rect.y = solid.y + solid.h;
+            }
+        }
+    }
+}
+
+/**
+* This method makes an enemy fire its weapon.
+*/
+void EnemyStore::shoot(const std::size_t index)
+{
+    const Weapon& weapon = ENEMY_TYPES[static_cast<int>(types[index])].weapon;
+    SDL_Point centre = { rects[index].x + (rects[index].w / 2), rects[index].y + (rects[index].h / 2) };
+
+    Mix_PlayChannel(-1, Application::getSound(GUN_SOUNDS.at(weapon)), 0);
+    projectiles->emplace_back(weapon, centre, angles[index]);
+}
+
+/**
+* This coroutine tells an alerted enemy to find a new path when the player has
+* moved, but no more often than every "ai_time" seconds. "navigation_event" is
+* signalled when the player moves.
+*/
+Behaviour EnemyStore::chaseBehaviour(const Handle handle, TimerWheel::Event& navigation_event)
+{
+    float ai_time = pathings[find(handle)].ai_time;
+    while (true)
+    {
+        co_await wheel.wait(ai_time);
+        co_await wheel.waitUntil([this, handle] { return pathings[find(handle)].navigation_version != navigation_version; }, navigation_event, REPLAN_POLL);
+        pathings[find(handle)].replan = true;
+    }
+}
+
+/**
+* This coroutine makes an alerted enemy shoot at the player.
+*/
+Behaviour EnemyStore::attackBehaviour(const Handle handle)
+{
+    const EnemyTypeData& data = ENEMY_TYPES[static_cast<int>(types[find(handle)])];
+    const float delay = WEAPON_DELAYS.at(data.weapon);
+    auto isFacingPlayer = [this, handle] { return attacks[find(handle)].facing_player; };
+
+    // Enemies that don't burst fire decide on every shot.
+    while (!data.burst_fire)
+    {
+        co_await wheel.wait(delay);
+        if (isFacingPlayer() && !Tools::randomInt(0, data.attack_chance))
+        {
+            shoot(find(handle));
+        }
+    }
+
+    // Enemies that burst fire have a chance of starting to shoot every second they can
+    // see the player, and then a chance of stopping every second. They always stop
+    // when they lose sight of the player.
+    while (true)
+    {
+        co_await wheel.waitUntil(isFacingPlayer, delay);
+        co_await wheel.wait(BURST_TIME);
+        if (!isFacingPlayer() || Tools::randomInt(0, data.attack_chance))
+        {
+            continue;
+        }
+
+        float burst_timer = 0.0;
+        while (true)
+        {
+            co_await wheel.wait(delay);
+            if (!isFacingPlayer())
+            {
+                break;
+            }
+            shoot(find(handle));
+
+            burst_timer += delay;
+            if (burst_timer >= BURST_TIME)
+            {
+                burst_timer = 0.0;
+                if (!Tools::randomInt(0, data.attack_chance))
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+* This coroutine makes an enemy that hasn't been alerted wait for a while each
+* time it gets to the end of its path, and then tells it to move on.
+*/
+Behaviour EnemyStore::patrolBehaviour(const Handle handle)
+{
+    while (true)
+    {
+        co_await wheel.waitUntil([this, handle] { return paths[find(handle)].empty(); }, patrols[find(handle)].path_finished, PATROL_POLL);
+        co_await wheel.wait(patrols[find(handle)].investigating ? INVESTIGATE_WAIT : Tools::randomFloat(PATROL_WAIT_MINIMUM, PATROL_WAIT_MAXIMUM));
+
+        // The enemy might have been sent to investigate something while it waited.
+        if (paths[find(handle)].empty())
+        {
+            patrols[find(handle)].move_on = true;
+        }
+    }
+}
+
+/**
+* This method determines if an enemy that hasn't been alerted can see the player.
+*/
+bool EnemyStore::canSeePlayer(const std::size_t index, Level& level, Player& player)
+{
+    SDL_Point centre = { rects[index].x + (rects[index].w / 2), rects[index].y + (rects[index].h / 2) };
+
+    // This checks if the player is in this enemy's line of sight.
+    if (!level.isInLineOfSight(centre, player.getCentre()))
+    {
+        return false;
+    }
+
+    int view = Tools::angleBetweenPoints(
+        centre.x,
+        centre.y,
+        player.getCentre().x,
+        player.getCentre().y
+    ) - 180;
+    return view > -90 || view < -270;
+}
+
+/**
+* This method gets a new path ready for an enemy. It removes the enemy's own tile
+* from the path, smooths the path so it only has the tiles where it turns, and
+* heads for the first of them.
+*/
+void EnemyStore::startPath(const std::size_t index, Level& level)
+{
+    const SDL_Rect& rect = rects[index];
+    paths[index].pop_back();
+    level.smoothPath(paths[index], { rect.x + (rect.w / 2), rect.y + (rect.h / 2) }, std::max(rect.w, rect.h) / 2);
+    setNextNode(index);
+}
+
+/**
+* This method sets the node rect of an enemy to the centre of the next tile in its path.
+*/
+void EnemyStore::setNextNode(const std::size_t index)
+{
+    if (!paths[index].empty())
+    {
+        SDL_Rect& node_rect = pathings[index].node_rect;
+        node_rect.x = (paths[index].back().x * Level::TILE_SIZE) + (Level::TILE_SIZE / 2) - (node_rect.w / 2);
+        node_rect.y = (paths[index].back().y * Level::TILE_SIZE) + (Level::TILE_SIZE / 2) - (node_rect.h / 2);
+    }
+}
+
+/**
+* This method swaps two enemies in every array, and keeps their handles pointing at them.
+*/
+void EnemyStore::swap(const std::size_t a, const std::size_t b)
+{
+    if (a == b)
+    {
+        return;
+    }
+
+    std::swap(rects[a], rects[b]);
+    std::swap(angles[a], angles[b]);
+    std::swap(movements[a], movements[b]);
+    std::swap(healths[a], healths[b]);
+    std::swap(types[a], types[b]);
+    std::swap(attacks[a], attacks[b]);
+    std::swap(pathings[a], pathings[b]);
+    std::swap(patrols[a], patrols[b]);
+    std::swap(paths[a], paths[b]);
+    std::swap(schedules[a], schedules[b]);
+    std::swap(slots[a], slots[b]);
+    std::swap(behaviours[a], behaviours[b]);
+
+    slot_indices[slots[a]] = static_cast<Uint32>(a);
+    slot_indices[slots[b]] = static_cast<Uint32>(b);
+}
\ No newline at end of file
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "Level.h"
+#include "Player.h"
+#include "Projectile.h"
+#include "EnemyTypes.h"
+#include "TimerWheel.h"
+
+/**
+* This class holds every enemy in the level. Each part of an enemy is kept in its own
+* array, so the update loops only touch the data they need and walk through it in order.
+* Enemies that have been alerted are kept at the front of the arrays, so the AI only
+* runs over the alerted enemies and the line of sight checks only run over the rest.
+* Enemies that haven't been alerted patrol around where they started, and go to
+* investigate gunshots they hear.
+*
+* Anything an enemy does on a timer, like shooting or deciding where to go next, is a
+* coroutine that waits on the store's timer wheel. An enemy that's waiting costs nothing
+* until its timer fires, so the work each frame depends on how many timers are due
+* rather than how many enemies there are.
+*
+* Enemies aren't all updated every frame. Enemies close to the player are, enemies further
+* away are updated every few frames with the time they missed, and enemies far away that
+* haven't been alerted sleep. Enemies that aren't close to the player are also only
+* updated while the frame's AI budget lasts. The budget is a number of updates rather
+* than a length of time, so the same enemies are updated however fast the game runs,
+* and replays stay in step. Any that miss out are updated first next frame.
+*
+* Enemies move around in the arrays when others are removed, so anything that needs to
+* remember an enemy between frames should keep its handle instead of its index. A handle
+* stops being valid as soon as its enemy is removed.
+*/
+class EnemyStore
+{
+public:
+    /**
+    * This struct refers to one enemy. The generation changes every time a slot is
+    * reused, so an old handle never refers to a new enemy.
+    */
+    struct Handle
+    {
+        Uint32 slot = 0;
+        Uint32 generation = 0;
+    };
+
+public:
+    /**
+    * This method adds an enemy in the middle of a tile, and returns its handle.
+    */
+    Handle spawn(const EnemyType type, const SDL_Rect& tile_rect);
+
+    /**
+    * This method removes the enemy at an index. The last enemy is moved into its place.
+    */
+    void remove(const std::size_t index);
+
+    /**
+    * This method removes every enemy.
+    */
+    void clear();
+
+    /**
+    * This method returns the number of enemies.
+    */
+    std::size_t size();
+
+    /**
+    * This method returns the index of the enemy a handle refers to, or -1 if the
+    * enemy has been removed.
+    */
+    int find(const Handle& handle);
+
+    /**
+    * This method returns the handle of the enemy at an index.
+    */
+    Handle getHandle(const std::size_t index);
+
+    /**
+    * This method updates every enemy. Alerted enemies follow their paths to the player
+    * and shoot, and the rest look out for the player.
+    */
+    void update(Level& level, Player& player, std::vector<Projectile>& enemy_projectiles);
+
+    /**
+    * This method sends every enemy that hasn't been alerted and is within "distance"
+    * of a noise to where the noise came from.
+    */
+    void investigate(Level& level, const SDL_Point& position, const int distance);
+
+    /**
+    * This method draws every enemy to the screen.
+    */
+    void draw();
+
+    /**
+    * This method damages the enemy at an index.
+    */
+    void damage(const std::size_t index, const int damage);
+
+    /**
+    * This method determines if the enemy at an index is dead and should be
+    * removed from the game or not.
+    */
+    bool isDead(const std::size_t index);
+
+    /**
+    * This method returns the rects of every enemy, in index order.
+    */
+    const std::vector<SDL_Rect>& getRects();
+
+    /**
+    * This method returns the angle of the enemy at an index.
+    */
+    int getAngle(const std::size_t index);
+
+    /**
+    * This method returns the health of the enemy at an index.
+    */
+    int getHealth(const std::size_t index);
+
+    /**
+    * This method returns the texture of the enemy at an index for when it dies.
+    */
+    SDL_Texture* getDeadTexture(const std::size_t index);
+
+    /**
+    * This method returns the weapon that the enemy at an index uses.
+    */
+    const Weapon& getWeapon(const std::size_t index);
+
+    /**
+    * This method returns how many enemies were updated last frame.
+    */
+    std::size_t getUpdatedCount();
+
+private:
+    /**
+    * This method decides how often each enemy should be updated, and which enemies
+    * are due an update this frame.
+    */
+    void updateSchedules(Player& player);
+
+    /**
+    * This method determines if a due enemy should be updated now. Enemies close to the
+    * player always are, and the rest are only updated while the AI budget lasts.
+    */
+    bool shouldUpdate(const std::size_t index);
+
+    /**
+    * This method moves an alerted enemy along its path, and turns it towards
+    * the player if it can see them.
+    */
+    void updatePath(const std::size_t index, Level& level, Player& player);
+
+    /**
+    * This method moves an enemy that hasn't been alerted along its patrol, or to
+    * whatever it's investigating. When its patrol behaviour says so, it picks a new
+    * tile near where it started.
+    */
+    void updatePatrol(const std::size_t index, Level& level);
+
+    /**
+    * This method moves an enemy towards the next node in its path at a speed, and
+    * returns false if it has reached the end of the path.
+    */
+    bool followPath(const std::size_t index, const float speed);
+
+    /**
+    * This method moves an enemy and handles its collisions.
+    */
+    void updateMovement(const std::size_t index, Level& level, Player& player, const float delta_time);
+
+    /**
+    * This method makes an enemy fire its weapon.
+    */
+    void shoot(const std::size_t index);
+
+    /**
+    * This coroutine tells an alerted enemy to find a new path when the player has
+    * moved, but no more often than every "ai_time" seconds. "navigation_event" is
+    * signalled when the player moves.
+    */
+    Behaviour chaseBehaviour(const Handle handle, TimerWheel::Event& navigation_event);
+
+    /**
+    * This coroutine makes an alerted enemy shoot at the player.
+    */
+    Behaviour attackBehaviour(const Handle handle);
+
+    /**
+    * This coroutine makes an enemy that hasn't been alerted wait for a while each
+    * time it gets to the end of its path, and then tells it to move on.
+    */
+    Behaviour patrolBehaviour(const Handle handle);
+
+    /**
+    * This method determines if an enemy that hasn't been alerted can see the player.
+    */
+    bool canSeePlayer(const std::size_t index, Level& level, Player& player);
+
+    /**
+    * This method gets a new path ready for an enemy. It removes the enemy's own tile
+    * from the path, smooths the path so it only has the tiles where it turns, and
+    * heads for the first of them.
+    */
+    void startPath(const std::size_t index, Level& level);
+
+    /**
+    * This method sets the node rect of an enemy to the centre of the next tile in its path.
+    */
+    void setNextNode(const std::size_t index);
+
+    /**
+    * This method swaps two enemies in every array, and keeps their handles pointing at them.
+    */
+    void swap(const std::size_t a, const std::size_t b);
+
+private:
+    /**
+    * This struct holds what an enemy's attack behaviour needs to know to decide
+    * when to shoot.
+    */
+    struct Attack
+    {
+        bool facing_player = false;
+    };
+
+    /**
+    * This struct holds what an enemy needs to decide when to find a new path. A path
+    * to the player is kept until the player moves to another tile, and the chase
+    * behaviour sets "replan" when it's time for a new one.
+    */
+    struct Pathing
+    {
+        float ai_time;
+        int navigation_version = -1;
+        bool replan = false;
+        SDL_Rect node_rect;
+    };
+
+    /**
+    * This struct holds where an enemy that hasn't been alerted patrols around. The
+    * patrol behaviour sets "move_on" when it's time to pick a new tile, and waits on
+    * "path_finished", which is signalled when the enemy gets to the end of its path.
+    */
+    struct Patrol
+    {
+        SDL_Point home_tile;
+        bool investigating = false;
+        bool move_on = false;
+        TimerWheel::Event path_finished;
+    };
+
+    /**
+    * This struct holds the coroutines that control an enemy. An enemy that hasn't been
+    * alerted only has a movement behaviour.
+    */
+    struct Behaviours
+    {
+        Behaviour movement;
+        Behaviour attack;
+    };
+
+    /**
+    * This struct holds how often an enemy is updated. An interval of 0 means the
+    * enemy is asleep. "elapsed" is the time since the enemy was last updated.
+    */
+    struct Schedule
+    {
+        int interval = 1;
+        int countdown = 0;
+        float elapsed = 0.0;
+    };
+
+    static const int NEAR_DISTANCE = 10 * Level::TILE_SIZE;
+    static const int FAR_DISTANCE = 25 * Level::TILE_SIZE;
+    static const int MIDDLE_INTERVAL = 4;
+    static const int FAR_INTERVAL = 8;
+    static const int AI_BUDGET = 256;
+    static constexpr float MAXIMUM_ELAPSED = 0.25;
+
+    static constexpr float AI_TIME_MINIUM = 0.5;
+    static constexpr float AI_TIME_MAXIMUM = 1.5;
+    static const int NODE_SIZE = 10;
+
+    static const int PATROL_RADIUS = 6;
+    static const int PATROL_ATTEMPTS = 4;
+    static constexpr float PATROL_SPEED = 0.4;
+    static constexpr float PATROL_WAIT_MINIMUM = 1.0;
+    static constexpr float PATROL_WAIT_MAXIMUM = 4.0;
+    static constexpr float INVESTIGATE_WAIT = 3.0;
+    static constexpr float PATROL_POLL = 1.0;
+    static constexpr float REPLAN_POLL = 1.0;
+    static constexpr float BURST_TIME = 1.0;
+    static constexpr Uint32 NO_INDEX = 0xFFFFFFFF;
+
+    // Enemies from 0 to "alerted_count" are alerted.
+    std::size_t alerted_count = 0;
+
+    // Data used every frame.
+    std::vector<SDL_Rect> rects;
+    std::vector<int> angles;
+    std::vector<Tools::FloatVector> movements;
+    std::vector<int> healths;
+    std::vector<EnemyType> types;
+    std::vector<Attack> attacks;
+    std::vector<Pathing> pathings;
+    std::vector<Patrol> patrols;
+    std::vector<Schedule> schedules;
+
+    // Data only used when paths change.
+    std::vector<std::deque<SDL_Point>> paths;
+
+    // The behaviours are destroyed before the timer wheel they wait on.
+    TimerWheel wheel;
+    std::vector<Behaviours> behaviours;
+    std::vector<Projectile>* projectiles = nullptr;
+    int navigation_version = 0;
+
+    // The slot of the enemy at each index, and the index and generation of each slot.
+    std::vector<Uint32> slots;
+    std::vector<Uint32> slot_indices;
+    std::vector<Uint32> slot_generations;
+    std::vector<Uint32> free_slots;
+
+    // The updates left in the AI budget for the current frame.
+    int budget_left = 0;
+    bool over_budget = false;
+    std::size_t updated_count = 0;
+    std::vector<std::size_t> spotted;
+
+    // Updates start from a different enemy every frame, so that the same enemies
+    // don't always miss out when the budget runs out.
+    std::size_t alerted_cursor = 0;
+    std::size_t unalerted_cursor = 0;
+
+    SDL_Texture* textures[static_cast<int>(EnemyType::Count)] = {};
+    SDL_Texture* dead_textures[static_cast<int>(EnemyType::Count)] = {};
+    Mix_Chunk* shout = nullptr;
+};
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Weapons.h"
+
+enum class EnemyType
+{
+    Guard,
+    Soldier,
+    Officer,
+    SchutzstaffelSoldier,
+    Count
+};
+
+/**
+* This struct holds everything that makes one type of enemy different from another.
+* Enemies that burst fire pick when to start and stop shooting once a second, and
+* then fire as fast as their weapon allows. The others decide on every shot.
+*/
+struct EnemyTypeData
+{
+    const char* texture;
+    const char* dead_texture;
+    int health;
+    int speed;
+    Weapon weapon;
+    int attack_chance;
+    bool burst_fire;
+};
+
+/**
+* This array is indexed by EnemyType.
+*/
+const EnemyTypeData ENEMY_TYPES[static_cast<int>(EnemyType::Count)] = {
+    { "Resources/Images/Guard.png", "Resources/Images/DeadGuard.png", 30, 150, Weapon::Handgun, 1, false },
+    { "Resources/Images/Soldier.png", "Resources/Images/DeadSoldier.png", 60, 150, Weapon::SubmachineGun, 2, true },
+    { "Resources/Images/Officer.png", "Resources/Images/DeadOfficer.png", 100, 150, Weapon::Rifle, 2, false },
+    { "Resources/Images/SchutzstaffelSoldier.png", "Resources/Images/DeadSchutzstaffelSoldier.png", 150, 150, Weapon::AssaultRifle, 3, true }
+};
\ No newline at end of file
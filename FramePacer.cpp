@@ -0,0 +1,202 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+
+/**
+* This namespace starts each frame at a steady rate. Frames are given deadlines a fixed
+* time apart, measured with the high resolution clock, so an early or late frame doesn't
+* move the frames after it. The pacer sleeps until just before the deadline, because
+* sleeping can overshoot by a millisecond or more, and then spins until the deadline.
+*
+* When vsync is on and the screen refreshes no faster than the frame rate, presenting
+* a frame already waits for the screen, so the pacer doesn't wait as well.
+*
+* The time between frames is kept in a histogram, and frames that took much longer than
+* they should have are counted as stutters.
+*/
+namespace FramePacer
+{
+    /**
+    * This anonymous namespace holds the deadline of the next frame, and the
+    * frame times so far.
+    */
+    namespace
+    {
+        // The pacer stops sleeping this long before the deadline, and spins instead.
+        const float SPIN_TIME = 0.002f;
+
+        // A frame stutters when it takes this many times longer than it should.
+        const float STUTTER_FRACTION = 1.5f;
+
+        Uint64 frequency = 1;
+        Uint64 period = 0;
+        Uint64 deadline = 0;
+        Uint64 last_start = 0;
+        int frame_rate = 0;
+        bool waiting = true;
+
+        // While throttled, this is used instead of "period", and the pacer always waits.
+        Uint64 throttle_period = 0;
+
+        /**
+        * This function returns the time between frames right now.
+        */
+        Uint64 getPeriod()
+        {
+            return throttle_period != 0 ? throttle_period : period;
+        }
+
+        std::vector<int> histogram(HISTOGRAM_SIZE, 0);
+        int stutter_count = 0;
+
+        /**
+        * This function adds the time between two frames to the histogram.
+        */
+        void addFrameTime(const Uint64 ticks)
+        {
+            int milliseconds = static_cast<int>((ticks * 1000) / frequency);
+            histogram[std::min(milliseconds, HISTOGRAM_SIZE - 1)]++;
+            if (ticks > getPeriod() * STUTTER_FRACTION)
+            {
+                stutter_count++;
+            }
+        }
+    }
+
+    /**
+    * This function sets the frame rate, and whether presenting waits for vsync.
+    */
+    void setup(const int frame_rate, const bool vsync)
+    {
+        FramePacer::frame_rate = std::max(frame_rate, 1);
+        frequency = SDL_GetPerformanceFrequency();
+        period = frequency / FramePacer::frame_rate;
+        throttle_period = 0;
+        waiting = true;
+
+        SDL_DisplayMode mode;
+        if (vsync && SDL_GetWindowDisplayMode(Application::getWindow(), &mode) == 0 && mode.refresh_rate > 0 && mode.refresh_rate <= frame_rate)
+        {
+            period = frequency / mode.refresh_rate;
+            waiting = false;
+        }
+        LOG_INFO("Frame pacing at " << (frequency / period) << "fps" << (waiting ? "" : " with vsync"));
+    }
+
+    /**
+    * This function makes the pacer wait for frames itself at a frame rate, even with
+    * vsync, for when frames aren't being presented or should run slower. A frame rate
+    * of 0 goes back to pacing as normal.
+    */
+    void setThrottle(const int frame_rate)
+    {
+        throttle_period = frame_rate > 0 ? frequency / frame_rate : 0;
+    }
+
+    /**
+    * This function returns the frame rate the pacer was set up with.
+    */
+    int getFrameRate()
+    {
+        return frame_rate;
+    }
+
+    /**
+    * This function starts timing from now. It should be called just before the
+    * first frame.
+    */
+    void start()
+    {
+        last_start = SDL_GetPerformanceCounter();
+        deadline = last_start;
+    }
+
+    /**
+    * This function is called after the game has been waiting for something else. If
+    * it waited longer than a frame, the next frame starts straight away, as if the last
+    * frame had taken as long as it should have, so the wait isn't a slow frame.
+    */
+    void skip()
+    {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now - last_start > getPeriod())
+        {
+            last_start = now - getPeriod();
+            deadline = last_start;
+        }
+    }
+
+    /**
+    * This function waits until the next frame should start, and returns the
+    * time in seconds since the last one started.
+    */
+    float wait()
+    {
+        Uint64 frame_period = getPeriod();
+        bool wait_for_deadline = waiting || throttle_period != 0;
+        deadline += frame_period;
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        // A frame that's more than a frame late starts the deadlines again from now,
+        // instead of rushing the frames after it to catch up.
+        if (now > deadline + frame_period || !wait_for_deadline)
+        {
+            deadline = now;
+        }
+
+        if (wait_for_deadline && now < deadline)
+        {
+            Uint64 spin_ticks = static_cast<Uint64>(SPIN_TIME * frequency);
+            if (deadline - now > spin_ticks)
+            {
+                SDL_Delay(static_cast<Uint32>(((deadline - now - spin_ticks) * 1000) / frequency));
+            }
+            while (now < deadline)
+            {
+                now = SDL_GetPerformanceCounter();
+            }
+        }
+
+        Uint64 frame_ticks = now - last_start;
+        last_start = now;
+        addFrameTime(frame_ticks);
+        return static_cast<float>(frame_ticks) / frequency;
+    }
+
+    /**
+    * This function returns how many frames took each whole number of milliseconds.
+    * Frames that took longer than the histogram are counted in the last bucket.
+    */
+    const std::vector<int>& getHistogram()
+    {
+        return histogram;
+    }
+
+    /**
+    * This function returns how many frames have stuttered.
+    */
+    int getStutterCount()
+    {
+        return stutter_count;
+    }
+
+    /**
+    * This function writes the histogram and the number of stutters to the log.
+    */
+    void logReport()
+    {
+        int frame_count = 0;
+        for (int milliseconds = 0; milliseconds < HISTOGRAM_SIZE; milliseconds++)
+        {
+            frame_count += histogram[milliseconds];
+        }
+        LOG_INFO("Frame times over " << frame_count << " frames, " << stutter_count << " stutters:");
+        for (int milliseconds = 0; milliseconds < HISTOGRAM_SIZE; milliseconds++)
+        {
+            if (histogram[milliseconds] > 0)
+            {
+                LOG_INFO("  " << milliseconds << (milliseconds == HISTOGRAM_SIZE - 1 ? "+" : "") << "ms: " << histogram[milliseconds]);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This namespace starts each frame at a steady rate. Frames are given deadlines a fixed
+* time apart, measured with the high resolution clock, so an early or late frame doesn't
+* move the frames after it. The pacer sleeps until just before the deadline, because
+* sleeping can overshoot by a millisecond or more, and then spins until the deadline.
+*
+* When vsync is on and the screen refreshes no faster than the frame rate, presenting
+* a frame already waits for the screen, so the pacer doesn't wait as well.
+*
+* The time between frames is kept in a histogram, and frames that took much longer than
+* they should have are counted as stutters.
+*/
+namespace FramePacer
+{
+    /**
+    * This function sets the frame rate, and whether presenting waits for vsync.
+    */
+    void setup(const int frame_rate, const bool vsync);
+
+    /**
+    * This function makes the pacer wait for frames itself at a frame rate, even with
+    * vsync, for when frames aren't being presented or should run slower. A frame rate
+    * of 0 goes back to pacing as normal.
+    */
+    void setThrottle(const int frame_rate);
+
+    /**
+    * This function returns the frame rate the pacer was set up with.
+    */
+    int getFrameRate();
+
+    /**
+    * This function starts timing from now. It should be called just before the
+    * first frame.
+    */
+    void start();
+
+    /**
+    * This function is called after the game has been waiting for something else. If
+    * it waited longer than a frame, the next frame starts straight away, as if the last
+    * frame had taken as long as it should have, so the wait isn't a slow frame.
+    */
+    void skip();
+
+    /**
+    * This function waits until the next frame should start, and returns the
+    * time in seconds since the last one started.
+    */
+    float wait();
+
+    /**
+    * This function returns how many frames took each whole number of milliseconds.
+    * Frames that took longer than the histogram are counted in the last bucket.
+    */
+    const std::vector<int>& getHistogram();
+
+    /**
+    * This function returns how many frames have stuttered.
+    */
+    int getStutterCount();
+
+    /**
+    * This function writes the histogram and the number of stutters to the log.
+    */
+    void logReport();
+
+    const int HISTOGRAM_SIZE = 50;
+}
\ No newline at end of file
@@ -1,7 +1,25 @@
 #include "GameState.h"
+#include "Compositor.h"
+#include "DynamicResolution.h"
+#include "Input.h"
 
 void GameState::startUp()
 {
+    // Everything that's drawn at an angle is rotated up front.
+    for (const auto& texture : PLAYER_TEXTURES)
+    {
+        SpriteCache::prepare(texture.second);
+    }
+    for (const auto& texture : PROJECTILE_TEXTURES)
+    {
+        SpriteCache::prepare(texture.second);
+    }
+    for (const auto& type : ENEMY_TYPES)
+    {
+        SpriteCache::prepare(type.texture);
+        SpriteCache::prepare(type.dead_texture);
+    }
+
     level_num = 1;
     level.load("Resources/Levels/" + std::to_string(level_num) + ".xml");
     level.render();
@@ -22,57 +40,46 @@ void GameState::startUp()
 
 void GameState::handleEvents()
 {
-    if (Application::getEvent().type == SDL_KEYDOWN)
-    {
-        if (Application::getEvent().key.keysym.sym == SDLK_ESCAPE)
-        {
-            Application::changeState("MAIN");
-        }
-        else
-        {
-            player.handleKeyPresses();
-        }
-    }
-    else if (Application::getEvent().type == SDL_KEYUP)
+    if (Input::wasKeyPressed(SDLK_ESCAPE))
     {
-        player.handleKeyReleases();
+        Application::changeState("MAIN");
+        return;
     }
-    else if (Application::getEvent().type == SDL_MOUSEBUTTONDOWN)
-    {
-        if (Application::getEvent().button.button == SDL_BUTTON_LEFT)
-        {
-            player.setShooting(true);
-        }
-    }
-    else if (Application::getEvent().type == SDL_MOUSEBUTTONUP)
-    {
-        if (Application::getEvent().button.button == SDL_BUTTON_LEFT)
-        {
-            player.setShooting(false);
-        }
-    }
-    else if (Application::getEvent().type == SDL_MOUSEWHEEL)
+
+    // A click that starts and ends in the same frame still fires for that frame.
+    player.handleInput();
+    player.setShooting(Input::isButtonDown(SDL_BUTTON_LEFT) || Input::wasButtonPressed(SDL_BUTTON_LEFT));
+    if (Input::getWheel() != 0)
     {
-        player.changeWeapon();
+        player.changeWeapon(Input::getWheel());
     }
 }
 
 void GameState::update()
 {
-    // Update the breadth first search every so often.
+    // Update the navigation field every so often.
     ai_timer += Application::getDeltaTime();
-    if (ai_timer >= BFS_UPDATE_TIME)
+    if (ai_timer >= NAVIGATION_UPDATE_TIME)
     {
         ai_timer = 0.0;
-        level.breadthFirstSearch({ player.getCentre().x / level.TILE_SIZE, player.getCentre().y / level.TILE_SIZE });
+        level.updateNavigation({ player.getCentre().x / level.TILE_SIZE, player.getCentre().y / level.TILE_SIZE });
+    }
+
+    // Let the autopilot control the player if it's on.
+    if (Autopilot::isEnabled())
+    {
+        autopilot.update(level, player, enemies, weapon_pickups, exit.second);
     }
 
-    // Update the player, the enemies and the projectiles.
-    player.update(level, enemies, player_projectiles);
-    for (auto& enemy : enemies)
+    // Update the player, the enemies and the projectiles. Enemies nearby hear the
+    // player's gunshots and go to see what's happening.
+    std::size_t projectile_count = player_projectiles.size();
+    player.update(level, enemies.getRects(), player_projectiles);
+    if (player_projectiles.size() > projectile_count)
     {
-        enemy->update(level, player, enemies, enemy_projectiles);
+        enemies.investigate(level, player.getCentre(), GUNSHOT_HEARING_DISTANCE);
     }
+    enemies.update(level, player, enemy_projectiles);
     for (auto& projectile : player_projectiles)
     {
         projectile.update();
@@ -154,41 +161,17 @@ void GameState::update()
     }
 
     // Update projectile/wall collisions.
-    for (auto& solid : level.getAllSolids())
-    {
-        for (auto& projectile = player_projectiles.begin(); projectile != player_projectiles.end();)
-        {
-            if (SDL_HasIntersection(&projectile->getRect(), &solid))
-            {
-                projectile = player_projectiles.erase(projectile);
-            }
-            else
-            {
-                projectile++;
-            }
-        }
-
-        for (auto& projectile = enemy_projectiles.begin(); projectile != enemy_projectiles.end();)
-        {
-            if (SDL_HasIntersection(&projectile->getRect(), &solid))
-            {
-                projectile = enemy_projectiles.erase(projectile);
-            }
-            else
-            {
-                projectile++;
-            }
-        }
-    }
+    level.removeProjectilesInSolids(player_projectiles);
+    level.removeProjectilesInSolids(enemy_projectiles);
 
     // Update projectile/enemy collisions.
-    for (auto& enemy = enemies.begin(); enemy != enemies.end();)
+    for (std::size_t enemy = 0; enemy < enemies.size();)
     {
         for (auto& projectile = player_projectiles.begin(); projectile != player_projectiles.end();)
         {
-            if (SDL_HasIntersection(&projectile->getRect(), &enemy->get()->getRect()))
+            if (SDL_HasIntersection(&projectile->getRect(), &enemies.getRects()[enemy]))
             {
-                enemy->get()->damage(projectile->getDamage());
+                enemies.damage(enemy, projectile->getDamage());
                 projectile = player_projectiles.erase(projectile);
             }
             else
@@ -197,16 +180,16 @@ void GameState::update()
             }
         }
 
-        if (enemy->get()->isDead())
+        if (enemies.isDead(enemy))
         {
             Mix_PlayChannel(-1, death_sound, 0);
 
-            SDL_Texture* texture = enemy->get()->getDeadTexture();
-            SDL_Rect rect = enemy->get()->getRect();
+            SDL_Texture* texture = enemies.getDeadTexture(enemy);
+            SDL_Rect rect = enemies.getRects()[enemy];
             SDL_QueryTexture(texture, nullptr, nullptr, &rect.w, &rect.h);
-            bodies.push_back(std::make_tuple(texture, rect, enemy->get()->getAngle()));
-            weapon_pickups.emplace_back(enemy->get()->getWeapon(), rect);
-            enemy = enemies.erase(enemy);
+            level.stampDecal(texture, rect, enemies.getAngle(enemy));
+            weapon_pickups.emplace_back(enemies.getWeapon(enemy), rect);
+            enemies.remove(enemy);
         }
         else
         {
@@ -230,7 +213,19 @@ void GameState::update()
 
     if (SDL_HasIntersection(&player.getRect(), &exit.second))
     {
-        if (std::experimental::filesystem::exists("Resources/Levels/" + std::to_string(++level_num) + ".xml"))
+        // The autopilot goes back to the first level after the last one, so it can
+        // play for as long as it needs to.
+        level_num++;
+        if (Autopilot::isEnabled())
+        {
+            autopilot.levelCompleted();
+            if (!std::experimental::filesystem::exists("Resources/Levels/" + std::to_string(level_num) + ".xml"))
+            {
+                level_num = 1;
+            }
+        }
+
+        if (std::experimental::filesystem::exists("Resources/Levels/" + std::to_string(level_num) + ".xml"))
         {
             level.load("Resources/Levels/" + std::to_string(level_num) + ".xml");
             level.render();
@@ -245,6 +240,14 @@ void GameState::update()
 
     if (player.isDead())
     {
+        if (Autopilot::isEnabled())
+        {
+            autopilot.playerDied();
+        }
+
+        // The bodies are removed along with everything else.
+        level.clearDecals();
+        level.render();
         player.spawn();
         setLevel();
     }
@@ -252,9 +255,12 @@ void GameState::update()
 
 void GameState::draw()
 {
+    // The world is drawn at whatever resolution keeps the frame time down, and the
+    // HUD is always drawn at the full resolution.
+    Compositor::beginWorld(DynamicResolution::getScale());
     level.draw();
     SDL_Rect draw_rect = Application::applyCamera(exit.second);
-    SDL_RenderCopy(Application::getRenderer(), exit.first, nullptr, &draw_rect);
+    Compositor::draw(exit.first, nullptr, draw_rect);
     for (auto& weapon_pickup : weapon_pickups)
     {
         weapon_pickup.draw();
@@ -267,11 +273,6 @@ void GameState::draw()
     {
         health_pickup.draw();
     }
-    for (auto& body : bodies)
-    {
-        draw_rect = Application::applyCamera(std::get<1>(body));
-        SDL_RenderCopyEx(Application::getRenderer(), std::get<0>(body), nullptr, &draw_rect, std::get<2>(body), nullptr, SDL_FLIP_NONE);
-    }
     for (auto& projectile : player_projectiles)
     {
         projectile.draw();
@@ -280,17 +281,44 @@ void GameState::draw()
     {
         projectile.draw();
     }
-    for (auto& enemy : enemies)
-    {
-        enemy->draw();
-    }
+    enemies.draw();
     player.draw();
+    Compositor::endWorld();
+
+    player.drawHUD();
 }
 
 void GameState::shutDown()
 {
 }
 
+Uint64 GameState::getStateHash()
+{
+    Replay::StateHash hash;
+    hash.add(level_num);
+    hash.add(player.getRect());
+    hash.add(player.getAngle());
+    hash.add(player.getHealth());
+    for (std::size_t enemy = 0; enemy < enemies.size(); enemy++)
+    {
+        hash.add(enemies.getRects()[enemy]);
+        hash.add(enemies.getAngle(enemy));
+        hash.add(enemies.getHealth(enemy));
+    }
+    for (auto& projectile : player_projectiles)
+    {
+        hash.add(projectile.getRect());
+    }
+    for (auto& projectile : enemy_projectiles)
+    {
+        hash.add(projectile.getRect());
+    }
+    hash.add(static_cast<int>(health_pickups.size()));
+    hash.add(static_cast<int>(ammo_pickups.size()));
+    hash.add(static_cast<int>(weapon_pickups.size()));
+    return hash.get();
+}
+
 void GameState::setLevel()
 {
     // Clear all of the previous data.
@@ -300,29 +328,22 @@ void GameState::setLevel()
     health_pickups.clear();
     player_projectiles.clear();
     enemy_projectiles.clear();
-    bodies.clear();
 
     player.setTile(level.getObjects('1')[0]);
-    level.breadthFirstSearch({ player.getCentre().x / level.TILE_SIZE, player.getCentre().y / level.TILE_SIZE });
+    autopilot.reset();
+    level.updateNavigation({ player.getCentre().x / level.TILE_SIZE, player.getCentre().y / level.TILE_SIZE });
 
-    // Disgusting amount of repitition, but it was taking me too long to figure
-    // out how to compress this down.
-    for (const auto& tile : level.getObjects('2'))
+    // Enemy object types '2' to '5' are in the same order as the enemy types.
+    for (int type = 0; type < static_cast<int>(EnemyType::Count); type++)
     {
-        enemies.push_back(std::make_shared<Guard>(tile));
-    }
-    for (const auto& tile : level.getObjects('3'))
-    {
-        enemies.push_back(std::make_shared<Soldier>(tile));
-    }
-    for (const auto& tile : level.getObjects('4'))
-    {
-        enemies.push_back(std::make_shared<Officer>(tile));
-    }
-    for (const auto& tile : level.getObjects('5'))
-    {
-        enemies.push_back(std::make_shared<SchutzstaffelSoldier>(tile));
+        for (const auto& tile : level.getObjects(static_cast<char>('2' + type)))
+        {
+            enemies.spawn(static_cast<EnemyType>(type), tile);
+        }
     }
+
+    // Disgusting amount of repitition, but it was taking me too long to figure
+    // out how to compress this down.
     for (const auto& tile : level.getObjects('6'))
     {
         weapon_pickups.emplace_back(Weapon::Handgun, tile);
@@ -2,13 +2,12 @@
 
 #include "Level.h"
 #include "Player.h"
-#include "Guard.h"
-#include "Soldier.h"
-#include "Officer.h"
-#include "SchutzstaffelSoldier.h"
+#include "EnemyStore.h"
 #include "Projectile.h"
 #include "AmmoPickup.h"
 #include "HealthPickup.h"
+#include "Replay.h"
+#include "Autopilot.h"
 #include <memory>
 #include <experimental/filesystem>
 
@@ -24,24 +23,26 @@ public:
     void update();
     void draw();
     void shutDown();
+    Uint64 getStateHash();
 
 private:
     void setLevel();
 
 private:
-    static constexpr float BFS_UPDATE_TIME = 0.5;
+    static constexpr float NAVIGATION_UPDATE_TIME = 0.5;
+    static const int GUNSHOT_HEARING_DISTANCE = 12 * Level::TILE_SIZE;
     float ai_timer = 0.0;
     int level_num;
 
     Level level;
     Player player;
-    std::vector<std::shared_ptr<Enemy>> enemies;
+    Autopilot autopilot;
+    EnemyStore enemies;
     std::vector<HealthPickup> health_pickups;
     std::vector<AmmoPickup> ammo_pickups;
     std::vector<WeaponPickup> weapon_pickups;
     std::vector<Projectile> player_projectiles;
     std::vector<Projectile> enemy_projectiles;
-    std::vector<std::tuple<SDL_Texture*, SDL_Rect, int>> bodies;
     std::pair<SDL_Texture*, SDL_Rect> exit;
     SDL_Cursor* cursor;
     Mix_Chunk* death_sound;
@@ -1,4 +1,5 @@
 #include "HealthPickup.h"
+#include "Compositor.h"
 
 HealthPickup::HealthPickup(const SDL_Rect& tile_rect)
 {
@@ -11,7 +12,7 @@ HealthPickup::HealthPickup(const SDL_Rect& tile_rect)
 void HealthPickup::draw()
 {
     SDL_Rect draw_rect = Application::applyCamera(rect);
-    SDL_RenderCopy(Application::getRenderer(), texture, nullptr, &draw_rect);
+    Compositor::draw(texture, nullptr, draw_rect);
 }
 
 const SDL_Rect& HealthPickup::getRect()
@@ -0,0 +1,247 @@
+#include "Input.h"
+#include "Replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+/**
+* This namespace turns each frame's input events into a snapshot, which states read once
+* a frame instead of handling events one at a time. The snapshot holds which keys and
+* mouse buttons are down, which were pressed or released this frame, how far the wheel
+* was scrolled and where the mouse is. Key repeats don't count as presses.
+*
+* The mouse can be sampled again just before it's used, so the player aims and is drawn
+* facing where the mouse is now, rather than where it was when the frame started. This
+* is only done while a replay isn't being recorded or played, so replays still only
+* depend on the recorded events.
+*
+* The time of the oldest input event in each frame is kept until the frame is presented,
+* so the time from input to the screen can be measured.
+*/
+namespace Input
+{
+    /**
+    * This anonymous namespace holds the snapshot, and the times from input to the
+    * screen so far.
+    */
+    namespace
+    {
+        std::unordered_set<SDL_Keycode> keys_down;
+        std::unordered_set<SDL_Keycode> keys_pressed;
+        std::unordered_set<SDL_Keycode> keys_released;
+        Uint32 buttons_down = 0;
+        Uint32 buttons_pressed = 0;
+        Uint32 buttons_released = 0;
+        int wheel = 0;
+        SDL_Point mouse_position = { 0, 0 };
+        Uint32 input_time = 0;
+
+        // These are added to by whichever thread presents frames.
+        std::atomic<Uint64> total_latency(0);
+        std::atomic<Uint32> maximum_latency(0);
+        std::atomic<Uint32> latency_count(0);
+
+        /**
+        * This function converts a point in the window to where it is on the render,
+        * the same way SDL converts the positions in mouse events.
+        */
+        SDL_Point toRenderPosition(const int x, const int y)
+        {
+            int window_width;
+            int window_height;
+            SDL_GetWindowSize(Application::getWindow(), &window_width, &window_height);
+
+            const SDL_Point& render_size = Application::getRenderSize();
+            float scale = std::min(static_cast<float>(window_width) / render_size.x, static_cast<float>(window_height) / render_size.y);
+            if (scale <= 0.0f)
+            {
+                return { x, y };
+            }
+
+            float border_x = (window_width - (render_size.x * scale)) / 2.0f;
+            float border_y = (window_height - (render_size.y * scale)) / 2.0f;
+            return { static_cast<int>((x - border_x) / scale), static_cast<int>((y - border_y) / scale) };
+        }
+    }
+
+    /**
+    * This function starts a new snapshot. Keys and buttons that are down stay down.
+    */
+    void beginFrame()
+    {
+        keys_pressed.clear();
+        keys_released.clear();
+        buttons_pressed = 0;
+        buttons_released = 0;
+        wheel = 0;
+        input_time = 0;
+    }
+
+    /**
+    * This function adds an event to the snapshot.
+    */
+    void handleEvent(const SDL_Event& event)
+    {
+        // Replayed events have no time, so they aren't measured.
+        if (Replay::isInputEvent(event) && event.common.timestamp != 0 && (input_time == 0 || event.common.timestamp < input_time))
+        {
+            input_time = event.common.timestamp;
+        }
+
+        switch (event.type)
+        {
+        case SDL_KEYDOWN:
+            if (!event.key.repeat)
+            {
+                keys_down.insert(event.key.keysym.sym);
+                keys_pressed.insert(event.key.keysym.sym);
+            }
+            break;
+        case SDL_KEYUP:
+            keys_down.erase(event.key.keysym.sym);
+            keys_released.insert(event.key.keysym.sym);
+            break;
+        case SDL_MOUSEMOTION:
+            mouse_position.x = event.motion.x;
+            mouse_position.y = event.motion.y;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+            buttons_down |= SDL_BUTTON(event.button.button);
+            buttons_pressed |= SDL_BUTTON(event.button.button);
+            break;
+        case SDL_MOUSEBUTTONUP:
+            buttons_down &= ~SDL_BUTTON(event.button.button);
+            buttons_released |= SDL_BUTTON(event.button.button);
+            break;
+        case SDL_MOUSEWHEEL:
+            wheel += event.wheel.y;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+    * This function returns whether a key is down.
+    */
+    bool isKeyDown(const SDL_Keycode key)
+    {
+        return keys_down.count(key) != 0;
+    }
+
+    /**
+    * This function returns whether a key was pressed this frame.
+    */
+    bool wasKeyPressed(const SDL_Keycode key)
+    {
+        return keys_pressed.count(key) != 0;
+    }
+
+    /**
+    * This function returns whether a key was released this frame.
+    */
+    bool wasKeyReleased(const SDL_Keycode key)
+    {
+        return keys_released.count(key) != 0;
+    }
+
+    /**
+    * This function returns whether a mouse button is down.
+    */
+    bool isButtonDown(const Uint8 button)
+    {
+        return (buttons_down & SDL_BUTTON(button)) != 0;
+    }
+
+    /**
+    * This function returns whether a mouse button was pressed this frame.
+    */
+    bool wasButtonPressed(const Uint8 button)
+    {
+        return (buttons_pressed & SDL_BUTTON(button)) != 0;
+    }
+
+    /**
+    * This function returns whether a mouse button was released this frame.
+    */
+    bool wasButtonReleased(const Uint8 button)
+    {
+        return (buttons_released & SDL_BUTTON(button)) != 0;
+    }
+
+    /**
+    * This function returns how far the wheel was scrolled this frame.
+    */
+    int getWheel()
+    {
+        return wheel;
+    }
+
+    /**
+    * This function returns where the mouse is in the snapshot, in render coordinates.
+    */
+    const SDL_Point& getMousePosition()
+    {
+        return mouse_position;
+    }
+
+    /**
+    * This function reads where the mouse is now, updates the snapshot with it, and
+    * returns it. While a replay is being recorded or played, the snapshot's position
+    * is returned as it is.
+    */
+    const SDL_Point& sampleMouse()
+    {
+        if (Replay::getMode() == Replay::Mode::Off)
+        {
+            int x;
+            int y;
+            SDL_GetMouseState(&x, &y);
+            mouse_position = toRenderPosition(x, y);
+        }
+        return mouse_position;
+    }
+
+    /**
+    * This function returns the time of the oldest input event this frame, in
+    * milliseconds, or 0 if there wasn't any.
+    */
+    Uint32 getInputTime()
+    {
+        return input_time;
+    }
+
+    /**
+    * This function is called once a frame has been presented, with the input time of
+    * that frame. It can be called from the render thread.
+    */
+    void addPresentTime(const Uint32 frame_input_time)
+    {
+        if (frame_input_time == 0)
+        {
+            return;
+        }
+
+        Uint32 latency = SDL_GetTicks() - frame_input_time;
+        total_latency += latency;
+        latency_count++;
+
+        Uint32 maximum = maximum_latency;
+        while (latency > maximum && !maximum_latency.compare_exchange_weak(maximum, latency))
+        {
+        }
+    }
+
+    /**
+    * This function writes the time from input to the screen to the log.
+    */
+    void logReport()
+    {
+        if (latency_count == 0)
+        {
+            return;
+        }
+        LOG_INFO("Input to screen over " << latency_count << " frames: mean " << (static_cast<float>(total_latency) / latency_count) << "ms, max " << maximum_latency << "ms");
+    }
+}
\ No newline at end of file
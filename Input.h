@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This namespace turns each frame's input events into a snapshot, which states read once
+* a frame instead of handling events one at a time. The snapshot holds which keys and
+* mouse buttons are down, which were pressed or released this frame, how far the wheel
+* was scrolled and where the mouse is. Key repeats don't count as presses.
+*
+* The mouse can be sampled again just before it's used, so the player aims and is drawn
+* facing where the mouse is now, rather than where it was when the frame started. This
+* is only done while a replay isn't being recorded or played, so replays still only
+* depend on the recorded events.
+*
+* The time of the oldest input event in each frame is kept until the frame is presented,
+* so the time from input to the screen can be measured.
+*/
+namespace Input
+{
+    /**
+    * This function starts a new snapshot. Keys and buttons that are down stay down.
+    */
+    void beginFrame();
+
+    /**
+    * This function adds an event to the snapshot.
+    */
+    void handleEvent(const SDL_Event& event);
+
+    /**
+    * This function returns whether a key is down.
+    */
+    bool isKeyDown(const SDL_Keycode key);
+
+    /**
+    * This function returns whether a key was pressed this frame.
+    */
+    bool wasKeyPressed(const SDL_Keycode key);
+
+    /**
+    * This function returns whether a key was released this frame.
+    */
+    bool wasKeyReleased(const SDL_Keycode key);
+
+    /**
+    * This function returns whether a mouse button is down.
+    */
+    bool isButtonDown(const Uint8 button);
+
+    /**
+    * This function returns whether a mouse button was pressed this frame.
+    */
+    bool wasButtonPressed(const Uint8 button);
+
+    /**
+    * This function returns whether a mouse button was released this frame.
+    */
+    bool wasButtonReleased(const Uint8 button);
+
+    /**
+    * This function returns how far the wheel was scrolled this frame.
+    */
+    int getWheel();
+
+    /**
+    * This function returns where the mouse is in the snapshot, in render coordinates.
+    */
+    const SDL_Point& getMousePosition();
+
+    /**
+    * This function reads where the mouse is now, updates the snapshot with it, and
+    * returns it. While a replay is being recorded or played, the snapshot's position
+    * is returned as it is.
+    */
+    const SDL_Point& sampleMouse();
+
+    /**
+    * This function returns the time of the oldest input event this frame, in
+    * milliseconds, or 0 if there wasn't any.
+    */
+    Uint32 getInputTime();
+
+    /**
+    * This function is called once a frame has been presented, with the input time of
+    * that frame. It can be called from the render thread.
+    */
+    void addPresentTime(const Uint32 frame_input_time);
+
+    /**
+    * This function writes the time from input to the screen to the log.
+    */
+    void logReport();
+}
\ No newline at end of file
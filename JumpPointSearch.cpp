@@ -0,0 +1,272 @@
+#include "JumpPointSearch.h"
+
+#include <algorithm>
+
+/**
+* This anonymous namespace holds the comparison that turns the open list into a heap
+* with the cheapest tile at the front, and a function for the direction between tiles.
+*/
+namespace
+{
+    template <typename Node>
+    bool isMoreExpensive(const Node& a, const Node& b)
+    {
+        return a.score > b.score;
+    }
+
+    int sign(const int value)
+    {
+        return (value > 0) - (value < 0);
+    }
+}
+
+/**
+* This method sets the level's grid, where '1' is solid. The grid must outlive
+* this object.
+*/
+void JumpPointSearch::setSolids(const std::vector<std::string>& solids)
+{
+    this->solids = &solids;
+    height = static_cast<int>(solids.size());
+    width = height > 0 ? static_cast<int>(solids[0].size()) : 0;
+
+    costs.assign(width * height, 0);
+    parents.assign(width * height, NO_TILE);
+    stamps.assign(width * height, 0);
+    closed_stamps.assign(width * height, 0);
+    current_stamp = 0;
+}
+
+/**
+* This method finds the shortest path between two tiles. It fills "path" with each
+* tile from "to_tile" to "from_tile", and returns false if there is no path.
+*/
+bool JumpPointSearch::findPath(const SDL_Point& from_tile, const SDL_Point& to_tile, std::deque<SDL_Point>& path)
+{
+    path.clear();
+    expanded_count = 0;
+    if (!isWalkable(from_tile.x, from_tile.y) || !isWalkable(to_tile.x, to_tile.y))
+    {
+        return false;
+    }
+
+    if (++current_stamp == 0)
+    {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        std::fill(closed_stamps.begin(), closed_stamps.end(), 0);
+        current_stamp = 1;
+    }
+    goal = to_tile;
+    open_list.clear();
+
+    Uint32 start = (from_tile.y * width) + from_tile.x;
+    Uint32 end = (to_tile.y * width) + to_tile.x;
+    costs[start] = 0;
+    parents[start] = NO_TILE;
+    stamps[start] = current_stamp;
+    open_list.push_back({ estimate(from_tile.x, from_tile.y), start });
+    expanded_count++;
+
+    while (!open_list.empty())
+    {
+        std::pop_heap(open_list.begin(), open_list.end(), isMoreExpensive<Node>);
+        Uint32 tile = open_list.back().tile;
+        open_list.pop_back();
+
+        // A tile can be in the open list more than once if a cheaper way to it was
+        // found after it was added.
+        if (closed_stamps[tile] == current_stamp)
+        {
+            continue;
+        }
+        closed_stamps[tile] = current_stamp;
+
+        if (tile == end)
+        {
+            // Walk back along the jump points, filling in the tiles between them.
+            SDL_Point current = to_tile;
+            path.push_back(current);
+            for (Uint32 parent = parents[end]; parent != NO_TILE; parent = parents[parent])
+            {
+                SDL_Point next = { static_cast<int>(parent % width), static_cast<int>(parent / width) };
+                int dx = sign(next.x - current.x);
+                int dy = sign(next.y - current.y);
+                while (current.x != next.x || current.y != next.y)
+                {
+                    current.x += dx;
+                    current.y += dy;
+                    path.push_back(current);
+                }
+            }
+            return true;
+        }
+
+        expand(tile % width, tile / width);
+    }
+
+    return false;
+}
+
+/**
+* This method returns how many tiles went into the open list during the last search.
+*/
+int JumpPointSearch::getExpandedCount()
+{
+    return expanded_count;
+}
+
+/**
+* This method adds every jump point that can be reached from a tile to the open list.
+*/
+void JumpPointSearch::expand(const int x, const int y)
+{
+    Uint32 tile = (y * width) + x;
+    Uint32 parent = parents[tile];
+
+    // The start tile can go in any direction.
+    if (parent == NO_TILE)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                if (dx != 0 || dy != 0)
+                {
+                    open(jump(x, y, dx, dy), tile);
+                }
+            }
+        }
+        return;
+    }
+
+    // Every other tile only needs to look in the directions that the path from its
+    // parent couldn't have got to more cheaply some other way.
+    int dx = sign(x - static_cast<int>(parent % width));
+    int dy = sign(y - static_cast<int>(parent / width));
+    if (dx != 0 && dy != 0)
+    {
+        open(jump(x, y, dx, 0), tile);
+        open(jump(x, y, 0, dy), tile);
+        open(jump(x, y, dx, dy), tile);
+    }
+    else if (dx != 0)
+    {
+        open(jump(x, y, dx, 0), tile);
+        open(jump(x, y, 0, 1), tile);
+        open(jump(x, y, 0, -1), tile);
+        open(jump(x, y, dx, 1), tile);
+        open(jump(x, y, dx, -1), tile);
+    }
+    else
+    {
+        open(jump(x, y, 0, dy), tile);
+        open(jump(x, y, 1, 0), tile);
+        open(jump(x, y, -1, 0), tile);
+        open(jump(x, y, 1, dy), tile);
+        open(jump(x, y, -1, dy), tile);
+    }
+}
+
+/**
+* This method moves from a tile in a direction until it finds a jump point, and
+* returns the jump point's index, or NO_TILE if it runs into a solid.
+*/
+Uint32 JumpPointSearch::jump(int x, int y, const int dx, const int dy)
+{
+    while (true)
+    {
+        // Diagonal moves can only be made if both of the tiles next to the
+        // corner are clear.
+        if (dx != 0 && dy != 0 && (!isWalkable(x + dx, y) || !isWalkable(x, y + dy)))
+        {
+            return NO_TILE;
+        }
+
+        x += dx;
+        y += dy;
+        if (!isWalkable(x, y))
+        {
+            return NO_TILE;
+        }
+        if (x == goal.x && y == goal.y)
+        {
+            return (y * width) + x;
+        }
+
+        // A tile is a jump point if the path might have to turn there. Moving straight,
+        // that's when a solid beside the path ends. Moving diagonally, it's when
+        // moving straight from the tile finds a jump point.
+        if (dx != 0 && dy != 0)
+        {
+            if (jump(x, y, dx, 0) != NO_TILE || jump(x, y, 0, dy) != NO_TILE)
+            {
+                return (y * width) + x;
+            }
+        }
+        else if (dx != 0)
+        {
+            if ((isWalkable(x, y - 1) && !isWalkable(x - dx, y - 1)) || (isWalkable(x, y + 1) && !isWalkable(x - dx, y + 1)))
+            {
+                return (y * width) + x;
+            }
+        }
+        else
+        {
+            if ((isWalkable(x - 1, y) && !isWalkable(x - 1, y - dy)) || (isWalkable(x + 1, y) && !isWalkable(x + 1, y - dy)))
+            {
+                return (y * width) + x;
+            }
+        }
+    }
+}
+
+/**
+* This method adds a jump point to the open list if it's the cheapest way found
+* to it so far.
+*/
+void JumpPointSearch::open(const Uint32 tile, const Uint32 parent)
+{
+    if (tile == NO_TILE || closed_stamps[tile] == current_stamp)
+    {
+        return;
+    }
+
+    // Jump points are always in a straight or diagonal line from their parent.
+    int x = tile % width;
+    int y = tile / width;
+    int distance_x = std::abs(x - static_cast<int>(parent % width));
+    int distance_y = std::abs(y - static_cast<int>(parent / width));
+    Uint32 diagonal = std::min(distance_x, distance_y);
+    Uint32 straight = std::max(distance_x, distance_y) - diagonal;
+    Uint32 cost = costs[parent] + (diagonal * DIAGONAL_COST) + (straight * STRAIGHT_COST);
+
+    if (stamps[tile] != current_stamp || cost < costs[tile])
+    {
+        stamps[tile] = current_stamp;
+        costs[tile] = cost;
+        parents[tile] = parent;
+        open_list.push_back({ cost + estimate(x, y), tile });
+        std::push_heap(open_list.begin(), open_list.end(), isMoreExpensive<Node>);
+        expanded_count++;
+    }
+}
+
+/**
+* This method returns the estimated cost from a tile to the goal. It's the cost
+* of the path if there were no solids in the way.
+*/
+Uint32 JumpPointSearch::estimate(const int x, const int y)
+{
+    Uint32 distance_x = std::abs(x - goal.x);
+    Uint32 distance_y = std::abs(y - goal.y);
+    Uint32 diagonal = std::min(distance_x, distance_y);
+    return (diagonal * DIAGONAL_COST) + ((std::max(distance_x, distance_y) - diagonal) * STRAIGHT_COST);
+}
+
+/**
+* This method determines if a tile is in the level and isn't solid.
+*/
+bool JumpPointSearch::isWalkable(const int x, const int y)
+{
+    return x >= 0 && y >= 0 && x < width && y < height && (*solids)[y][x] != '1';
+}
\ No newline at end of file
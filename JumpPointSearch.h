@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Application.h"
+#include <deque>
+
+/**
+* This class finds paths between two tiles with Jump Point Search. It's A* on a grid where
+* every move costs the same, except that it skips along straight and diagonal lines until
+* it reaches a tile where the path might have to turn. Only those tiles go into the open
+* list, so open areas take far fewer steps than A* or a breadth first search.
+*
+* Like the navigation fields, diagonal moves can't cut across the corner of a solid tile.
+*
+* The open list and the per-tile data are kept between searches and only grow, so a
+* search doesn't allocate any memory once the planner has warmed up.
+*/
+class JumpPointSearch
+{
+public:
+    /**
+    * This method sets the level's grid, where '1' is solid. The grid must outlive
+    * this object.
+    */
+    void setSolids(const std::vector<std::string>& solids);
+
+    /**
+    * This method finds the shortest path between two tiles. It fills "path" with each
+    * tile from "to_tile" to "from_tile", and returns false if there is no path.
+    */
+    bool findPath(const SDL_Point& from_tile, const SDL_Point& to_tile, std::deque<SDL_Point>& path);
+
+    /**
+    * This method returns how many tiles went into the open list during the last search.
+    */
+    int getExpandedCount();
+
+public:
+    static constexpr Uint32 STRAIGHT_COST = 10;
+    static constexpr Uint32 DIAGONAL_COST = 14;
+
+private:
+    /**
+    * This struct holds one tile in the open list.
+    */
+    struct Node
+    {
+        Uint32 score;
+        Uint32 tile;
+    };
+
+    /**
+    * This method adds every jump point that can be reached from a tile to the open list.
+    */
+    void expand(const int x, const int y);
+
+    /**
+    * This method moves from a tile in a direction until it finds a jump point, and
+    * returns the jump point's index, or NO_TILE if it runs into a solid.
+    */
+    Uint32 jump(int x, int y, const int dx, const int dy);
+
+    /**
+    * This method adds a jump point to the open list if it's the cheapest way found
+    * to it so far.
+    */
+    void open(const Uint32 tile, const Uint32 parent);
+
+    /**
+    * This method returns the estimated cost from a tile to the goal. It's the cost
+    * of the path if there were no solids in the way.
+    */
+    Uint32 estimate(const int x, const int y);
+
+    /**
+    * This method determines if a tile is in the level and isn't solid.
+    */
+    bool isWalkable(const int x, const int y);
+
+private:
+    static constexpr Uint32 NO_TILE = 0xFFFFFFFF;
+
+    const std::vector<std::string>* solids = nullptr;
+    int width = 0;
+    int height = 0;
+    SDL_Point goal = { 0, 0 };
+
+    // A tile's cost and parent are only valid if its stamp matches "current_stamp", and
+    // a tile has been closed if its closed stamp does. This saves clearing them before
+    // every search.
+    std::vector<Uint32> costs;
+    std::vector<Uint32> parents;
+    std::vector<Uint32> stamps;
+    std::vector<Uint32> closed_stamps;
+    Uint32 current_stamp = 0;
+
+    // A binary heap, with the cheapest tile at the front.
+    std::vector<Node> open_list;
+    int expanded_count = 0;
+};
\ No newline at end of file
@@ -1,8 +1,18 @@
 #include "Level.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+#include "TextureCache.h"
+
+#include <cmath>
+#include <limits>
 
 Level::~Level()
 {
-    SDL_DestroyTexture(texture);
+    RenderThread::call([&] {
+        TextureCache::remove(texture);
+        Compositor::removeImage(texture);
+        SDL_DestroyTexture(texture);
+    });
 }
 
 /**
@@ -15,10 +25,12 @@ void Level::load(const std::string& file_name)
     solids.clear();
     objects.clear();
     solids_rects.clear();
+    decals.clear();
     std::string solid_tiles;
+    std::map<char, int> costs;
 
     this->file_name = file_name;
-    OUTPUT("Loading level: " << this->file_name);
+    LOG_INFO("Loading level: " << this->file_name);
 
     // Open the level file.
     tinyxml2::XMLDocument doc(true, tinyxml2::COLLAPSE_WHITESPACE);
@@ -44,22 +56,38 @@ void Level::load(const std::string& file_name)
                 if (name == "title")
                 {
                     title = text;
-                    OUTPUT("Level title: " << title);
+                    LOG_DEBUG("Level title: " << title);
                 }
                 else if (name == "width")
                 {
                     width = atoi(text.c_str());
-                    OUTPUT("Level width: " << width);
+                    LOG_DEBUG("Level width: " << width);
                 }
                 else if (name == "height")
                 {
                     height = atoi(text.c_str());
-                    OUTPUT("Level height: " << height);
+                    LOG_DEBUG("Level height: " << height);
                 }
                 else if (name == "solids")
                 {
                     solid_tiles = text;
-                    OUTPUT("Level solids: " << solid_tiles);
+                    LOG_DEBUG("Level solids: " << solid_tiles);
+                }
+                else if (name == "costs")
+                {
+                    // Costs are written as "tile:cost" pairs, such as "4:3 5:2". Tiles
+                    // that aren't listed cost 1.
+                    for (const auto& pair : Tools::splitText(text, ' '))
+                    {
+                        if (pair.size() < 3 || pair[1] != ':')
+                        {
+                            SDL_SetError(("Invalid tile cost \"" + pair + "\" in " + this->file_name).c_str());
+                            throw Application::Error::XML;
+                        }
+                        int cost = atoi(pair.substr(2).c_str());
+                        costs[pair[0]] = cost < 1 ? 1 : (cost > MAXIMUM_TILE_COST ? MAXIMUM_TILE_COST : cost);
+                    }
+                    LOG_DEBUG("Level costs: " << text);
                 }
             }
         }
@@ -72,7 +100,7 @@ void Level::load(const std::string& file_name)
 
                 if (data_node_name == "layers")
                 {
-#ifdef OUTPUT_ENABLED
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_DEBUG
                     int layer_count = 0;
 #endif
 
@@ -83,9 +111,9 @@ void Level::load(const std::string& file_name)
                         auto layer_data = Tools::splitText(layer_text, ' ');
                         map_data.push_back(layer_data);
 
-#ifdef OUTPUT_ENABLED
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_DEBUG
                         std::replace(layer_text.begin(), layer_text.end(), ' ', '\n');
-                        OUTPUT("Layer " << ++layer_count << ":" << std::endl << layer_text);
+                        LOG_DEBUG("Layer " << ++layer_count << ":" << std::endl << layer_text);
 #endif
                     }
 
@@ -119,14 +147,23 @@ void Level::load(const std::string& file_name)
                     std::string object_text = data_node->ToElement()->GetText();
                     objects = Tools::splitText(object_text, ' ');
 
-#ifdef OUTPUT_ENABLED
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_DEBUG
                     std::replace(object_text.begin(), object_text.end(), ' ', '\n');
-                    OUTPUT("Objects: " << std::endl << object_text);
+                    LOG_DEBUG("Objects: " << std::endl << object_text);
 #endif
                 }
             }
         }
     }
+
+    setTileCosts(costs);
+    planner.setSolids(solids);
+    visibility.setSolids(solids, TILE_SIZE);
+    if (width * height <= VISIBILITY_PRECOMPUTE_TILES)
+    {
+        visibility.buildAll();
+        LOG_INFO("Built visibility for " << visibility.getBuiltCount() << " tiles in " << visibility.getBuildTime() * 1000.0f << "ms, using " << visibility.getMemory() / 1024 << "KB");
+    }
 }
 
 /**
@@ -135,53 +172,79 @@ void Level::load(const std::string& file_name)
 */
 void Level::render()
 {
-    // If we are rendering a new map, we need to free the old map texture.
-    if (texture != nullptr)
-    {
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
-    }
-
-    // Create a new map texture and set it as the render target.
-    texture = SDL_CreateTexture(Application::getRenderer(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width * TILE_SIZE, height * TILE_SIZE);
-    SDL_SetRenderTarget(Application::getRenderer(), texture);
-    SDL_RenderClear(Application::getRenderer());
-
-    // Tile variables.
-    SDL_Texture* tile_texture;
-    SDL_Rect tile_rect = { 0, 0, TILE_SIZE, TILE_SIZE };
+    RenderThread::call([&] {
+        // The old map texture is reused if the new map is the same size, otherwise
+        // it is freed.
+        if (texture != nullptr)
+        {
+            int texture_width, texture_height;
+            SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
+            if (texture_width != width * TILE_SIZE || texture_height != height * TILE_SIZE)
+            {
+                TextureCache::remove(texture);
+                Compositor::removeImage(texture);
+                SDL_DestroyTexture(texture);
+                texture = nullptr;
+            }
+        }
 
-    // Loop through every layer in the map and draw it to the map texture.
-    for (const auto& layer : map_data)
-    {
-        for (int y = 0; y < height; y++)
+        // Create a new map texture if needed and set it as the render target.
+        if (texture == nullptr)
+        {
+            texture = SDL_CreateTexture(Application::getRenderer(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width * TILE_SIZE, height * TILE_SIZE);
+            TextureCache::add(texture);
+        }
+        SDL_SetRenderTarget(Application::getRenderer(), texture);
+        SDL_RenderClear(Application::getRenderer());
+
+        // Tile variables.
+        SDL_Texture* tile_texture;
+        SDL_Rect tile_rect = { 0, 0, TILE_SIZE, TILE_SIZE };
+
+        // Loop through every layer in the map and draw it to the map texture. The
+        // cache is held while the tiles are drawn, so each tile is only loaded once,
+        // and it's trimmed once they're all drawn.
+        TextureCache::hold();
+        for (const auto& layer : map_data)
         {
-            for (int x = 0; x < width; x++)
+            for (int y = 0; y < height; y++)
             {
-                // Ignore empty tiles.
-                if (layer[y][x] == '0')
+                for (int x = 0; x < width; x++)
                 {
-                    continue;
-                }
+                    // Ignore empty tiles.
+                    if (layer[y][x] == '0')
+                    {
+                        continue;
+                    }
 
-                std::string image_file = "Resources/Images/Tiles/";
-                image_file += layer[y][x];
-                image_file += ".png";
+                    std::string image_file = "Resources/Images/Tiles/";
+                    image_file += layer[y][x];
+                    image_file += ".png";
 
-                tile_texture = Application::getTexture(image_file);
-                tile_rect.x = x * TILE_SIZE;
-                tile_rect.y = y * TILE_SIZE;
-                SDL_RenderCopy(Application::getRenderer(), tile_texture, nullptr, &tile_rect);
+                    // Tiles are only needed here, so they can be freed when textures
+                    // are over budget once the level is drawn.
+                    tile_texture = Application::getTexture(image_file, false);
+                    tile_rect.x = x * TILE_SIZE;
+                    tile_rect.y = y * TILE_SIZE;
+                    SDL_RenderCopy(Application::getRenderer(), tile_texture, nullptr, &tile_rect);
+                }
             }
         }
-    }
+        TextureCache::release();
+
+        for (const auto& decal : decals)
+        {
+            drawDecal(decal);
+        }
 
-    // Finish rendering map texture and set the renderer back to the screen.
-    SDL_RenderPresent(Application::getRenderer());
-    SDL_SetRenderTarget(Application::getRenderer(), nullptr);
+        // Finish rendering map texture and set the renderer back to the screen.
+        Compositor::capture(texture);
+        SDL_RenderPresent(Application::getRenderer());
+        SDL_SetRenderTarget(Application::getRenderer(), nullptr);
 
-    // Set the map rect.
-    rect = { 0, 0, width * TILE_SIZE, height * TILE_SIZE };
+        // Set the map rect.
+        rect = { 0, 0, width * TILE_SIZE, height * TILE_SIZE };
+    });
 }
 
 /**
@@ -190,7 +253,45 @@ void Level::render()
 void Level::draw()
 {
     SDL_Rect draw_rect = Application::applyCamera(rect);
-    SDL_RenderCopy(Application::getRenderer(), texture, nullptr, &draw_rect);
+    Compositor::draw(texture, nullptr, draw_rect);
+}
+
+/**
+* This method permanently draws a texture onto the level texture. It's used for
+* things that never move once they're in the level, like bodies, so they cost
+* nothing to draw after this.
+*/
+void Level::stampDecal(SDL_Texture* decal_texture, const SDL_Rect& decal_rect, const int angle)
+{
+    decals.push_back(std::make_tuple(decal_texture, decal_rect, angle));
+
+    RenderThread::call([&] {
+        SDL_SetRenderTarget(Application::getRenderer(), texture);
+        drawDecal(decals.back());
+
+        // A rotated decal can cover a square as wide as its diagonal.
+        int side = static_cast<int>(std::ceil(std::sqrt((decal_rect.w * decal_rect.w) + (decal_rect.h * decal_rect.h))));
+        SDL_Rect covered = { decal_rect.x + (decal_rect.w / 2) - (side / 2) - 1, decal_rect.y + (decal_rect.h / 2) - (side / 2) - 1, side + 2, side + 2 };
+        Compositor::capture(texture, &covered);
+        SDL_SetRenderTarget(Application::getRenderer(), nullptr);
+    });
+}
+
+/**
+* This method removes every decal. The level has to be rendered again
+* for them to disappear.
+*/
+void Level::clearDecals()
+{
+    decals.clear();
+}
+
+/**
+* This method draws a decal onto the level texture, which must be the render target.
+*/
+void Level::drawDecal(const std::tuple<SDL_Texture*, SDL_Rect, int>& decal)
+{
+    SpriteCache::draw(std::get<0>(decal), std::get<1>(decal), std::get<2>(decal));
 }
 
 /**
@@ -237,6 +338,113 @@ const std::vector<SDL_Rect>& Level::getAllSolids()
     return solids_rects;
 }
 
+/**
+* This method determines if there is a clear line between two points,
+* meaning that the line doesn't pass through any solids.
+*/
+bool Level::isInLineOfSight(const SDL_Point& from, const SDL_Point& to)
+{
+    // Most lines are ruled out by the potentially visible set, and the rest are traced.
+    SDL_Point from_tile = { from.x / TILE_SIZE, from.y / TILE_SIZE };
+    SDL_Point to_tile = { to.x / TILE_SIZE, to.y / TILE_SIZE };
+    return visibility.isVisible(from_tile, to_tile) && visibility.traceLine(from, to);
+}
+
+/**
+* This method determines if something "clearance" pixels either side of its centre
+* could move in a straight line between two points without touching any solids.
+*/
+bool Level::isPathClear(const SDL_Point& from, const SDL_Point& to, const int clearance)
+{
+    // The centre line and the lines followed by the corners of the walker's box.
+    const int OFFSETS[5][2] = {
+        { 0, 0 },
+        { -clearance, -clearance },
+        { clearance, -clearance },
+        { -clearance, clearance },
+        { clearance, clearance }
+    };
+
+    for (const auto& offset : OFFSETS)
+    {
+        if (!visibility.traceLine({ from.x + offset[0], from.y + offset[1] }, { to.x + offset[0], to.y + offset[1] }))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* This method removes every tile from a path that can be skipped by walking in a
+* straight line, leaving only the tiles where the path turns. The path runs from its
+* front to "start", which is the walker's centre, and the walker is "clearance"
+* pixels either side of its centre. A straight line is only taken if it doesn't
+* cross any tile that costs more than the tiles it skips.
+*/
+void Level::smoothPath(std::deque<SDL_Point>& path, const SDL_Point& start, const int clearance)
+{
+    // Starting from the walker, keep going along the path for as long as there's a
+    // clear line back to the last waypoint. The tile before the first one that
+    // can't be seen becomes the next waypoint. The line can't go over anything more
+    // expensive than the path it replaces, otherwise it would cut straight through the
+    // mud the path was planned to go around.
+    waypoints.clear();
+    SDL_Point anchor = start;
+    std::size_t next = path.size();
+    while (next > 0)
+    {
+        std::size_t furthest = next - 1;
+        int path_cost = getTileCost(path[furthest].x, path[furthest].y);
+        while (furthest > 0)
+        {
+            const SDL_Point& tile = path[furthest - 1];
+            SDL_Point centre = { (tile.x * TILE_SIZE) + (TILE_SIZE / 2), (tile.y * TILE_SIZE) + (TILE_SIZE / 2) };
+            path_cost = std::max(path_cost, getTileCost(tile.x, tile.y));
+            if (!isPathClear(anchor, centre, clearance) || getHighestCost(anchor, centre, clearance) > path_cost)
+            {
+                break;
+            }
+            furthest--;
+        }
+
+        waypoints.push_back(path[furthest]);
+        anchor = { (path[furthest].x * TILE_SIZE) + (TILE_SIZE / 2), (path[furthest].y * TILE_SIZE) + (TILE_SIZE / 2) };
+        next = furthest;
+    }
+
+    path.assign(waypoints.rbegin(), waypoints.rend());
+}
+
+/**
+* This method returns the level's potentially visible set.
+*/
+Visibility& Level::getVisibility()
+{
+    return visibility;
+}
+
+/**
+* This method removes every projectile that has hit a solid.
+*/
+void Level::removeProjectilesInSolids(std::vector<Projectile>& projectiles)
+{
+    for (auto& solid : solids_rects)
+    {
+        for (auto projectile = projectiles.begin(); projectile != projectiles.end();)
+        {
+            if (SDL_HasIntersection(&projectile->getRect(), &solid))
+            {
+                projectile = projectiles.erase(projectile);
+            }
+            else
+            {
+                projectile++;
+            }
+        }
+    }
+}
+
 /**
 * This method returns a vector of the rects of every object of a
 * certain type.
@@ -283,78 +491,207 @@ int Level::getHeight()
 }
 
 /**
-* This method generates a map of every tile in the grid. Any point in this map
-* can be traced back to start_tile which can be used to create a path.
+* This method makes "start_tile" the tile that "getPathToTile" and "hasPathToTile"
+* lead to, building its navigation field if it isn't cached.
 */
-void Level::breadthFirstSearch(const SDL_Point& start_tile)
+void Level::updateNavigation(const SDL_Point& start_tile)
 {
-    this->start_tile = start_tile;
-    std::queue<SDL_Point> frontier;
-    frontier.push(this->start_tile);
-
-    if (!came_from.empty())
+    if (start_tile.x != this->start_tile.x || start_tile.y != this->start_tile.y)
     {
-        came_from.clear();
+        navigation_version++;
+        navigation_event.signal();
     }
+    this->start_tile = start_tile;
+    navigation.getField(start_tile);
+}
 
-    // Every path found by the algorithm starts here, so we set it to itself.
-    came_from[std::make_pair(this->start_tile.x, this->start_tile.y)] = std::make_pair(this->start_tile.x, this->start_tile.y);
+/**
+* This method returns a number that changes every time "start_tile" changes, so
+* paths from "getPathToTile" can be kept until it does.
+*/
+int Level::getNavigationVersion()
+{
+    return navigation_version;
+}
 
-    SDL_Point current;
-    while (!frontier.empty())
-    {
-        current = frontier.front();
+/**
+* This method returns the event that's signalled every time the navigation
+* version changes.
+*/
+TimerWheel::Event& Level::getNavigationEvent()
+{
+    return navigation_event;
+}
 
-        // Check every tile above, below and to the sides of the current tile.
-        checkTile(frontier, current.x + 1, current.y, current);
-        checkTile(frontier, current.x - 1, current.y, current);
-        checkTile(frontier, current.x, current.y + 1, current);
-        checkTile(frontier, current.x, current.y - 1, current);
+/**
+* This method returns a deque of each tile from "start_tile" to "end_tile".
+*/
+std::deque<SDL_Point> Level::getPathToTile(const SDL_Point& end_tile)
+{
+    return navigation.getField(start_tile).getPath(end_tile);
+}
 
-        // Check every tile diagonally to the current tile, to allow for diagonal pathfinding.
-        checkTile(frontier, current.x + 1, current.y - 1, current);
-        checkTile(frontier, current.x + 1, current.y + 1, current);
-        checkTile(frontier, current.x - 1, current.y - 1, current);
-        checkTile(frontier, current.x - 1, current.y + 1, current);
+/**
+* This method determines if the navigation field reached a tile, meaning
+* there is a path from the tile to "start_tile".
+*/
+bool Level::hasPathToTile(const SDL_Point& tile)
+{
+    return navigation.getField(start_tile).isReachable(tile);
+}
 
-        frontier.pop();
-    }
+/**
+* This method finds the shortest path between two tiles, ignoring tile costs. It
+* fills "path" with each tile from "to_tile" to "from_tile", and returns false if
+* there is no path.
+*/
+bool Level::findPath(const SDL_Point& from_tile, const SDL_Point& to_tile, std::deque<SDL_Point>& path)
+{
+    return planner.findPath(from_tile, to_tile, path);
 }
 
 /**
-* This method returns a deque of each tile from "end_tile" to "start_tile".
+* This method returns the level's path planner.
 */
-std::deque<SDL_Point> Level::getPathToTile(const SDL_Point& end_tile)
+JumpPointSearch& Level::getPlanner()
 {
-    std::deque<SDL_Point> path;
-    if (solids[end_tile.y][end_tile.x] == '0')
-    {
-        std::pair<int, int> current_tile(end_tile.x, end_tile.y);
-        path.push_front({ current_tile.first, current_tile.second });
+    return planner;
+}
+
+/**
+* This method returns the level's navigation field cache, which holds the fields
+* for every other tile AI is heading for.
+*/
+NavigationCache& Level::getNavigation()
+{
+    return navigation;
+}
 
-        while (came_from[current_tile] != std::make_pair(start_tile.x, start_tile.y))
+/**
+* This method works out the cost of walking over every tile. Solid tiles cost 0,
+* and every other tile costs the most of any of its layers' tiles.
+*/
+void Level::setTileCosts(const std::map<char, int>& costs)
+{
+    tile_costs.assign(width * height, 1);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
         {
-            current_tile = came_from[current_tile];
-            path.push_front({ current_tile.first, current_tile.second });
+            Uint8& tile_cost = tile_costs[(y * width) + x];
+            if (solids[y][x] == '1')
+            {
+                tile_cost = 0;
+                continue;
+            }
+
+            for (const auto& layer : map_data)
+            {
+                auto cost = costs.find(layer[y][x]);
+                if (cost != costs.end())
+                {
+                    tile_cost = std::max(tile_cost, static_cast<Uint8>(cost->second));
+                }
+            }
         }
+    }
+    navigation.setCosts(tile_costs, width, height);
+    navigation_version++;
+    navigation_event.signal();
+    navigation.setBudget(NAVIGATION_CACHE_BUDGET);
+}
 
-        path.push_front(start_tile);
+/**
+* This method returns the cost of walking over a tile, or 0 if it's outside the level.
+*/
+int Level::getTileCost(const int x, const int y)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+    {
+        return 0;
     }
-    return path;
+    return tile_costs[(y * width) + x];
 }
 
 /**
-* This method checks a tile in the "solids" grid and finds out if the
-* tile is solid or not and if the tile has been checked before.
+* This method returns the cost of the most expensive tile that something "clearance"
+* pixels either side of its centre would walk over going in a straight line between
+* two points.
 */
-void Level::checkTile(std::queue<SDL_Point>& frontier, const int x, const int y, const SDL_Point& previous)
+int Level::getHighestCost(const SDL_Point& from, const SDL_Point& to, const int clearance)
 {
-    if (solids[y][x] == '0')
+    // The same lines as "isPathClear" checks.
+    const int OFFSETS[5][2] = {
+        { 0, 0 },
+        { -clearance, -clearance },
+        { clearance, -clearance },
+        { -clearance, clearance },
+        { clearance, clearance }
+    };
+
+    int highest = 0;
+    for (const auto& offset : OFFSETS)
     {
-        if (came_from.find(std::make_pair(x, y)) == came_from.end())
+        highest = std::max(highest, getHighestCostOnLine({ from.x + offset[0], from.y + offset[1] }, { to.x + offset[0], to.y + offset[1] }));
+    }
+    return highest;
+}
+
+/**
+* This method returns the cost of the most expensive tile that a line between two
+* points goes through.
+*/
+int Level::getHighestCostOnLine(const SDL_Point& from, const SDL_Point& to)
+{
+    // This walks the tiles the same way as "Visibility::traceLine", from the centres
+    // of the pixels.
+    double x1 = from.x + 0.5;
+    double y1 = from.y + 0.5;
+    double x2 = to.x + 0.5;
+    double y2 = to.y + 0.5;
+
+    int x = static_cast<int>(std::floor(x1 / TILE_SIZE));
+    int y = static_cast<int>(std::floor(y1 / TILE_SIZE));
+    int end_x = static_cast<int>(std::floor(x2 / TILE_SIZE));
+    int end_y = static_cast<int>(std::floor(y2 / TILE_SIZE));
+    int highest = getTileCost(x, y);
+
+    const double INFINITE = std::numeric_limits<double>::infinity();
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    int step_x = dx > 0 ? 1 : -1;
+    int step_y = dy > 0 ? 1 : -1;
+    double next_x = dx != 0 ? (((x + (step_x > 0 ? 1 : 0)) * TILE_SIZE) - x1) / dx : INFINITE;
+    double next_y = dy != 0 ? (((y + (step_y > 0 ? 1 : 0)) * TILE_SIZE) - y1) / dy : INFINITE;
+    double delta_x = dx != 0 ? TILE_SIZE / std::abs(dx) : INFINITE;
+    double delta_y = dy != 0 ? TILE_SIZE / std::abs(dy) : INFINITE;
+
+    int steps = std::abs(end_x - x) + std::abs(end_y - y);
+    while (steps > 0 && (x != end_x || y != end_y))
+    {
+        if (next_x < next_y)
+        {
+            x += step_x;
+            next_x += delta_x;
+            steps--;
+        }
+        else if (next_y < next_x)
+        {
+            y += step_y;
+            next_y += delta_y;
+            steps--;
+        }
+        else
         {
-            frontier.push({ x, y });
-            came_from[std::make_pair(x, y)] = std::make_pair(previous.x, previous.y);
+            // Going exactly through a corner touches both tiles beside it.
+            highest = std::max({ highest, getTileCost(x + step_x, y), getTileCost(x, y + step_y) });
+            x += step_x;
+            y += step_y;
+            next_x += delta_x;
+            next_y += delta_y;
+            steps -= 2;
         }
+        highest = std::max(highest, getTileCost(x, y));
     }
+    return highest;
 }
\ No newline at end of file
@@ -2,10 +2,15 @@
 
 #include "Application.h"
 #include "Tools.h"
+#include "Projectile.h"
+#include "Visibility.h"
+#include "NavigationCache.h"
+#include "JumpPointSearch.h"
+#include "TimerWheel.h"
 #include <algorithm>
 #include <deque>
-#include <queue>
 #include <map>
+#include <tuple>
 
 /**
 * This class handles the game levels. It loads all of the information
@@ -33,6 +38,19 @@ public:
     */
     void draw();
 
+    /**
+    * This method permanently draws a texture onto the level texture. It's used for
+    * things that never move once they're in the level, like bodies, so they cost
+    * nothing to draw after this.
+    */
+    void stampDecal(SDL_Texture* decal_texture, const SDL_Rect& decal_rect, const int angle);
+
+    /**
+    * This method removes every decal. The level has to be rendered again
+    * for them to disappear.
+    */
+    void clearDecals();
+
     /**
     * This method returns a vector of rects. Each rect is a solid
     * that is adjascent to the the tile coordinate arguments.
@@ -45,6 +63,37 @@ public:
     */
     const std::vector<SDL_Rect>& getAllSolids();
 
+    /**
+    * This method determines if there is a clear line between two points,
+    * meaning that the line doesn't pass through any solids.
+    */
+    bool isInLineOfSight(const SDL_Point& from, const SDL_Point& to);
+
+    /**
+    * This method determines if something "clearance" pixels either side of its centre
+    * could move in a straight line between two points without touching any solids.
+    */
+    bool isPathClear(const SDL_Point& from, const SDL_Point& to, const int clearance);
+
+    /**
+    * This method removes every tile from a path that can be skipped by walking in a
+    * straight line, leaving only the tiles where the path turns. The path runs from its
+    * front to "start", which is the walker's centre, and the walker is "clearance"
+    * pixels either side of its centre. A straight line is only taken if it doesn't
+    * cross any tile that costs more than the tiles it skips.
+    */
+    void smoothPath(std::deque<SDL_Point>& path, const SDL_Point& start, const int clearance);
+
+    /**
+    * This method returns the level's potentially visible set.
+    */
+    Visibility& getVisibility();
+
+    /**
+    * This method removes every projectile that has hit a solid.
+    */
+    void removeProjectilesInSolids(std::vector<Projectile>& projectiles);
+
     /**
     * This method returns a vector of the rects of every object of a
     * certain type.
@@ -67,29 +116,97 @@ public:
     int getHeight();
 
     /**
-    * This method generates a map of every tile in the grid. Any point in this map
-    * can be traced back to "start_tile" which can be used to create a path.
+    * This method makes "start_tile" the tile that "getPathToTile" and "hasPathToTile"
+    * lead to, building its navigation field if it isn't cached.
     */
-    void breadthFirstSearch(const SDL_Point& start_tile);
+    void updateNavigation(const SDL_Point& start_tile);
 
     /**
-    * This method returns a deque of each tile from "end_tile" to "start_tile".
+    * This method returns a number that changes every time "start_tile" changes, so
+    * paths from "getPathToTile" can be kept until it does.
+    */
+    int getNavigationVersion();
+
+    /**
+    * This method returns the event that's signalled every time the navigation
+    * version changes.
+    */
+    TimerWheel::Event& getNavigationEvent();
+
+    /**
+    * This method returns a deque of each tile from "start_tile" to "end_tile".
     */
     std::deque<SDL_Point> getPathToTile(const SDL_Point& end_tile);
 
+    /**
+    * This method determines if the navigation field reached a tile, meaning
+    * there is a path from the tile to "start_tile".
+    */
+    bool hasPathToTile(const SDL_Point& tile);
+
+    /**
+    * This method finds the shortest path between two tiles, ignoring tile costs. It
+    * fills "path" with each tile from "to_tile" to "from_tile", and returns false if
+    * there is no path.
+    */
+    bool findPath(const SDL_Point& from_tile, const SDL_Point& to_tile, std::deque<SDL_Point>& path);
+
+    /**
+    * This method returns the level's path planner.
+    */
+    JumpPointSearch& getPlanner();
+
+    /**
+    * This method returns the level's navigation field cache, which holds the fields
+    * for every other tile AI is heading for.
+    */
+    NavigationCache& getNavigation();
+
 private:
+    /**
+    * This method draws a decal onto the level texture, which must be the render target.
+    */
+    void drawDecal(const std::tuple<SDL_Texture*, SDL_Rect, int>& decal);
 
     /**
-    * This method checks a tile in the "solids" grid and finds out if the
-    * tile is solid or not and if the tile has been checked before.
+    * This method works out the cost of walking over every tile. Solid tiles cost 0,
+    * and every other tile costs the most of any of its layers' tiles.
     */
-    void checkTile(std::queue<SDL_Point>& frontier, const int x, const int y, const SDL_Point& previous);
+    void setTileCosts(const std::map<char, int>& costs);
+
+    /**
+    * This method returns the cost of walking over a tile, or 0 if it's outside the level.
+    */
+    int getTileCost(const int x, const int y);
+
+    /**
+    * This method returns the cost of the most expensive tile that something "clearance"
+    * pixels either side of its centre would walk over going in a straight line between
+    * two points.
+    */
+    int getHighestCost(const SDL_Point& from, const SDL_Point& to, const int clearance);
+
+    /**
+    * This method returns the cost of the most expensive tile that a line between two
+    * points goes through.
+    */
+    int getHighestCostOnLine(const SDL_Point& from, const SDL_Point& to);
 
 public:
     static const int TILE_SIZE = 50;
 
+    // Levels with up to this many tiles have their whole potentially visible set
+    // built when they're loaded. Bigger levels build it as it's needed.
+    static const int VISIBILITY_PRECOMPUTE_TILES = 64 * 64;
+
+    // The most a tile can cost to walk over. Ordinary tiles cost 1.
+    static const int MAXIMUM_TILE_COST = 15;
+
+    // How many bytes the cached navigation fields can use.
+    static const std::size_t NAVIGATION_CACHE_BUDGET = 8 * 1024 * 1024;
+
 private:
-    SDL_Texture* texture;
+    SDL_Texture* texture = nullptr;
     SDL_Rect rect;
 
     std::string file_name;
@@ -101,7 +218,18 @@ private:
     std::vector<std::string> solids;
     std::vector<std::string> objects;
     std::vector<SDL_Rect> solids_rects;
+    Visibility visibility;
+
+    // Decals are kept so that they can be stamped again when the level is rendered.
+    std::vector<std::tuple<SDL_Texture*, SDL_Rect, int>> decals;
+
+    std::vector<Uint8> tile_costs;
+    NavigationCache navigation;
+    JumpPointSearch planner;
+    SDL_Point start_tile = { 0, 0 };
+    int navigation_version = 0;
+    TimerWheel::Event navigation_event;
 
-    std::map<std::pair<int, int>, std::pair<int, int>> came_from;
-    SDL_Point start_tile;
+    // This is reused by every call to "smoothPath".
+    std::vector<SDL_Point> waypoints;
 };
\ No newline at end of file
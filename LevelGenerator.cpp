@@ -0,0 +1,318 @@
+#include "LevelGenerator.h"
+
+#include <algorithm>
+#include <queue>
+
+LevelGenerator::LevelGenerator(const Settings& settings) : settings(settings)
+{
+}
+
+/**
+* This method generates the level. It can be called again after changing
+* the settings to generate a different level.
+*/
+void LevelGenerator::generate()
+{
+    random.seed(settings.seed);
+
+    carveMaze();
+    carveRooms();
+    decorateWalls();
+    placeObjects();
+}
+
+/**
+* This method writes the generated level to a level file.
+*/
+void LevelGenerator::save(const std::string& file_name)
+{
+    // Every row goes on its own line, just like the hand made levels.
+    auto joinRows = [](const std::vector<std::string>& rows, const std::string& indent) {
+        std::string text;
+        for (const auto& row : rows)
+        {
+            text += "\n" + indent + row;
+        }
+        return text + "\n" + indent.substr(1);
+    };
+
+    tinyxml2::XMLDocument doc;
+    tinyxml2::XMLElement* level_element = doc.NewElement("level");
+    tinyxml2::XMLElement* about_element = doc.NewElement("about");
+    tinyxml2::XMLElement* data_element = doc.NewElement("data");
+    tinyxml2::XMLElement* layers_element = doc.NewElement("layers");
+    tinyxml2::XMLElement* layer_element = doc.NewElement("layer");
+    tinyxml2::XMLElement* objects_element = doc.NewElement("objects");
+
+    std::pair<const char*, std::string> about[] = {
+        { "title", settings.title },
+        { "width", std::to_string(settings.width) },
+        { "height", std::to_string(settings.height) },
+        { "solids", std::string(1, HORIZONTAL_WALL_TILE) + VERTICAL_WALL_TILE }
+    };
+    for (const auto& setting : about)
+    {
+        tinyxml2::XMLElement* setting_element = doc.NewElement(setting.first);
+        setting_element->SetText(setting.second.c_str());
+        about_element->LinkEndChild(setting_element);
+    }
+
+    layer_element->SetText(joinRows(layer, "\t\t\t\t").c_str());
+    objects_element->SetText(joinRows(objects, "\t\t\t").c_str());
+
+    layers_element->LinkEndChild(layer_element);
+    data_element->LinkEndChild(layers_element);
+    data_element->LinkEndChild(objects_element);
+    level_element->LinkEndChild(about_element);
+    level_element->LinkEndChild(data_element);
+    doc.LinkEndChild(level_element);
+
+    if (doc.SaveFile(file_name.c_str()) != tinyxml2::XML_SUCCESS)
+    {
+        SDL_SetError(doc.ErrorName());
+        throw Application::Error::XML;
+    }
+}
+
+/**
+* This method returns the settings used to generate the level.
+*/
+LevelGenerator::Settings& LevelGenerator::getSettings()
+{
+    return settings;
+}
+
+/**
+* This method fills the level with walls and then carves a maze into it.
+*/
+void LevelGenerator::carveMaze()
+{
+    layer = std::vector<std::string>(settings.height, std::string(settings.width, VERTICAL_WALL_TILE));
+
+    // Maze cells sit on odd coordinates, and the tiles between them are the walls
+    // that can be knocked through.
+    int cells_x = (settings.width - 1) / 2;
+    int cells_y = (settings.height - 1) / 2;
+    if (cells_x <= 0 || cells_y <= 0)
+    {
+        return;
+    }
+
+    // Carve a perfect maze with an iterative depth first search.
+    std::vector<bool> visited(cells_x * cells_y, false);
+    std::vector<SDL_Point> stack = { { 0, 0 } };
+    visited[0] = true;
+    layer[1][1] = FLOOR_TILE;
+
+    const SDL_Point directions[4] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+    while (!stack.empty())
+    {
+        SDL_Point cell = stack.back();
+
+        SDL_Point neighbours[4];
+        int neighbour_count = 0;
+        for (const auto& direction : directions)
+        {
+            SDL_Point neighbour = { cell.x + direction.x, cell.y + direction.y };
+            if (neighbour.x >= 0 && neighbour.x < cells_x && neighbour.y >= 0 && neighbour.y < cells_y && !visited[neighbour.y * cells_x + neighbour.x])
+            {
+                neighbours[neighbour_count++] = neighbour;
+            }
+        }
+
+        if (neighbour_count == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        SDL_Point next = neighbours[random.nextInt(0, neighbour_count - 1)];
+        visited[next.y * cells_x + next.x] = true;
+        layer[(cell.y + next.y) + 1][(cell.x + next.x) + 1] = FLOOR_TILE;
+        layer[(next.y * 2) + 1][(next.x * 2) + 1] = FLOOR_TILE;
+        stack.push_back(next);
+    }
+
+    // Knock down some of the remaining walls between cells to make loops.
+    float removal_chance = 1.0f - std::max(0.0f, std::min(1.0f, settings.maze_density));
+    for (int y = 1; y < (cells_y * 2); y++)
+    {
+        for (int x = 1; x < (cells_x * 2); x++)
+        {
+            // Walls between two horizontally or vertically adjacent cells.
+            bool between_x = (x % 2 == 0) && (y % 2 == 1);
+            bool between_y = (x % 2 == 1) && (y % 2 == 0);
+            if ((between_x || between_y) && layer[y][x] != FLOOR_TILE && random.nextFloat(0.0f, 1.0f) < removal_chance)
+            {
+                layer[y][x] = FLOOR_TILE;
+            }
+        }
+    }
+}
+
+/**
+* This method carves open rooms into the maze.
+*/
+void LevelGenerator::carveRooms()
+{
+    for (int room = 0; room < settings.room_count; room++)
+    {
+        int room_width = random.nextInt(settings.room_min_size, settings.room_max_size);
+        int room_height = random.nextInt(settings.room_min_size, settings.room_max_size);
+
+        // Rooms never touch the outer wall.
+        room_width = std::min(room_width, settings.width - 2);
+        room_height = std::min(room_height, settings.height - 2);
+        if (room_width <= 0 || room_height <= 0)
+        {
+            return;
+        }
+
+        int room_x = random.nextInt(1, settings.width - 1 - room_width);
+        int room_y = random.nextInt(1, settings.height - 1 - room_height);
+        for (int y = room_y; y < room_y + room_height; y++)
+        {
+            for (int x = room_x; x < room_x + room_width; x++)
+            {
+                layer[y][x] = FLOOR_TILE;
+            }
+        }
+    }
+}
+
+/**
+* This method picks the wall tile for every solid tile, so that walls
+* look the same as they do in the hand made levels.
+*/
+void LevelGenerator::decorateWalls()
+{
+    for (int y = 0; y < settings.height; y++)
+    {
+        for (int x = 0; x < settings.width; x++)
+        {
+            if (layer[y][x] == FLOOR_TILE)
+            {
+                continue;
+            }
+
+            // Walls that continue up or down are vertical, everything else is horizontal.
+            bool wall_above = y > 0 && layer[y - 1][x] != FLOOR_TILE;
+            bool wall_below = y < settings.height - 1 && layer[y + 1][x] != FLOOR_TILE;
+            layer[y][x] = (wall_above || wall_below) ? VERTICAL_WALL_TILE : HORIZONTAL_WALL_TILE;
+        }
+    }
+}
+
+/**
+* This method places the player, the exit, the enemies and the pickups.
+*/
+void LevelGenerator::placeObjects()
+{
+    objects = std::vector<std::string>(settings.height, std::string(settings.width, EMPTY));
+
+    // The player starts at the first floor tile, and the exit goes on the reachable
+    // tile furthest away from it.
+    SDL_Point start = { -1, -1 };
+    for (int y = 0; y < settings.height && start.x < 0; y++)
+    {
+        for (int x = 0; x < settings.width && start.x < 0; x++)
+        {
+            if (layer[y][x] == FLOOR_TILE)
+            {
+                start = { x, y };
+            }
+        }
+    }
+    if (start.x < 0)
+    {
+        return;
+    }
+
+    std::vector<SDL_Point> reachable = findReachableTiles(start);
+    objects[start.y][start.x] = '1';
+    objects[reachable.back().y][reachable.back().x] = 'H';
+
+    // Objects are only placed on reachable tiles. Enemies aren't placed right next to
+    // the player's starting tile, so the player doesn't die straight away.
+    const int SAFE_DISTANCE = 5;
+    std::vector<SDL_Point> free_tiles;
+    for (const auto& tile : reachable)
+    {
+        if (objects[tile.y][tile.x] == EMPTY)
+        {
+            free_tiles.push_back(tile);
+        }
+    }
+
+    // Shuffle the free tiles, and then take tiles from the end as they're needed.
+    for (int i = static_cast<int>(free_tiles.size()) - 1; i > 0; i--)
+    {
+        std::swap(free_tiles[i], free_tiles[random.nextInt(0, i)]);
+    }
+
+    for (int type = 0; type < 4; type++)
+    {
+        for (int i = 0; i < settings.enemy_counts[type] && !free_tiles.empty(); i++)
+        {
+            SDL_Point tile = free_tiles.back();
+            free_tiles.pop_back();
+            if (std::abs(tile.x - start.x) <= SAFE_DISTANCE && std::abs(tile.y - start.y) <= SAFE_DISTANCE)
+            {
+                i--;
+                continue;
+            }
+            objects[tile.y][tile.x] = static_cast<char>('2' + type);
+        }
+    }
+
+    // Pickups are weapons ('6' to 'A'), ammo ('B' to 'F') and health ('G').
+    const std::string PICKUPS = "6789ABCDEFG";
+    for (const auto& tile : free_tiles)
+    {
+        if (random.nextFloat(0.0f, 1.0f) < settings.pickup_density)
+        {
+            objects[tile.y][tile.x] = PICKUPS[random.nextInt(0, static_cast<int>(PICKUPS.size()) - 1)];
+        }
+    }
+}
+
+/**
+* This method returns every floor tile reachable from "start", ordered by distance.
+*/
+std::vector<SDL_Point> LevelGenerator::findReachableTiles(const SDL_Point& start)
+{
+    std::vector<SDL_Point> reachable;
+    std::vector<bool> visited(settings.width * settings.height, false);
+    std::queue<SDL_Point> frontier;
+
+    frontier.push(start);
+    visited[start.y * settings.width + start.x] = true;
+    while (!frontier.empty())
+    {
+        SDL_Point current = frontier.front();
+        frontier.pop();
+        reachable.push_back(current);
+
+        const SDL_Point directions[4] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (const auto& direction : directions)
+        {
+            int x = current.x + direction.x;
+            int y = current.y + direction.y;
+            if (isFloor(x, y) && !visited[y * settings.width + x])
+            {
+                visited[y * settings.width + x] = true;
+                frontier.push({ x, y });
+            }
+        }
+    }
+
+    return reachable;
+}
+
+/**
+* This method returns whether a tile is inside the level and is floor.
+*/
+bool LevelGenerator::isFloor(const int x, const int y)
+{
+    return x >= 0 && x < settings.width && y >= 0 && y < settings.height && layer[y][x] == FLOOR_TILE;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Application.h"
+#include "Random.h"
+
+/**
+* This class procedurally generates levels in the same format as the levels in
+* "Resources/Levels". It's used to make large levels for benchmarking, so the same
+* settings and seed always generate the same level.
+*/
+class LevelGenerator
+{
+public:
+    /**
+    * This struct holds every setting that controls how a level is generated.
+    */
+    struct Settings
+    {
+        std::string title = "Generated";
+        int width = 64;
+        int height = 64;
+        Uint64 seed = 0;
+
+        // The fraction of maze walls that are kept. 1 gives a perfect maze with a single
+        // route between any two tiles, 0 removes every wall between maze cells.
+        float maze_density = 0.75;
+
+        // Rooms are open rectangles carved over the top of the maze.
+        int room_count = 8;
+        int room_min_size = 3;
+        int room_max_size = 10;
+
+        // The number of each type of enemy, in the order of their object types '2' to '5'.
+        int enemy_counts[4] = { 8, 4, 2, 1 };
+
+        // The chance of any floor tile getting a pickup.
+        float pickup_density = 0.01f;
+    };
+
+public:
+    LevelGenerator(const Settings& settings);
+
+    /**
+    * This method generates the level. It can be called again after changing
+    * the settings to generate a different level.
+    */
+    void generate();
+
+    /**
+    * This method writes the generated level to a level file.
+    */
+    void save(const std::string& file_name);
+
+    /**
+    * This method returns the settings used to generate the level.
+    */
+    Settings& getSettings();
+
+private:
+    /**
+    * This method fills the level with walls and then carves a maze into it.
+    */
+    void carveMaze();
+
+    /**
+    * This method carves open rooms into the maze.
+    */
+    void carveRooms();
+
+    /**
+    * This method picks the wall tile for every solid tile, so that walls
+    * look the same as they do in the hand made levels.
+    */
+    void decorateWalls();
+
+    /**
+    * This method places the player, the exit, the enemies and the pickups.
+    */
+    void placeObjects();
+
+    /**
+    * This method returns every floor tile reachable from "start", ordered by distance.
+    */
+    std::vector<SDL_Point> findReachableTiles(const SDL_Point& start);
+
+    /**
+    * This method returns whether a tile is inside the level and is floor.
+    */
+    bool isFloor(const int x, const int y);
+
+private:
+    static constexpr char FLOOR_TILE = '1';
+    static constexpr char HORIZONTAL_WALL_TILE = '2';
+    static constexpr char VERTICAL_WALL_TILE = '3';
+    static constexpr char EMPTY = '0';
+
+    Settings settings;
+    Random::Generator random;
+
+    std::vector<std::string> layer;
+    std::vector<std::string> objects;
+};
\ No newline at end of file
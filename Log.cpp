@@ -0,0 +1,272 @@
+#include "Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+* This anonymous namespace holds the ring buffer and the background thread. The ring
+* buffer is a bounded queue where every slot has a sequence number. Producers claim a
+* slot by moving "enqueue_position" along, and then publish it by setting its sequence
+* number. The background thread is the only consumer, so it doesn't need to claim slots.
+*/
+namespace
+{
+    /**
+    * This struct holds one message in the ring buffer.
+    */
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        Log::Severity severity;
+        float time;
+        std::size_t length;
+        char text[Log::MESSAGE_SIZE];
+    };
+
+    /**
+    * This stream buffer writes into a slot's text. It stops writing when the slot is
+    * full instead of allocating more space.
+    */
+    class SlotBuffer : public std::streambuf
+    {
+    public:
+        void reset(char* text, const std::size_t size)
+        {
+            setp(text, text + size);
+        }
+
+        std::size_t getLength()
+        {
+            return pptr() - pbase();
+        }
+
+    protected:
+        int overflow(int) override
+        {
+            return traits_type::eof();
+        }
+    };
+
+    static_assert((Log::BUFFER_MESSAGES & (Log::BUFFER_MESSAGES - 1)) == 0, "BUFFER_MESSAGES must be a power of two.");
+
+    const char* SEVERITY_NAMES[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+    const auto start_time = std::chrono::steady_clock::now();
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<std::size_t> enqueue_position(0);
+    alignas(64) std::atomic<std::size_t> dequeue_position(0);
+    std::atomic<std::uint64_t> dropped(0);
+
+    std::once_flag start_flag;
+    std::atomic<bool> running(false);
+    std::atomic<bool> stopping(false);
+    std::thread writer;
+
+    // Only the background thread writes to the output, but the output can be changed
+    // from any thread.
+    std::mutex output_mutex;
+    std::ofstream file;
+    std::ostream* output = &std::cout;
+
+    // Each thread formats its messages with its own stream.
+    thread_local SlotBuffer slot_buffer;
+    thread_local std::ostream slot_stream(&slot_buffer);
+    thread_local Slot* current_slot = nullptr;
+    thread_local std::size_t current_position = 0;
+
+    /**
+    * This function writes every published message to the output, and returns how
+    * many it wrote.
+    */
+    std::size_t writeMessages()
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+        std::size_t count = 0;
+
+        while (true)
+        {
+            Slot& slot = slots[position & (Log::BUFFER_MESSAGES - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                break;
+            }
+
+            *output << "[" << std::fixed << std::setprecision(3) << slot.time << "] "
+                << SEVERITY_NAMES[static_cast<int>(slot.severity)] << ": ";
+            output->write(slot.text, slot.length);
+            *output << '\n';
+
+            // Give the slot back to the producers for the next time around the buffer.
+            slot.sequence.store(position + Log::BUFFER_MESSAGES, std::memory_order_release);
+            position++;
+            count++;
+        }
+
+        if (count > 0)
+        {
+            output->flush();
+            dequeue_position.store(position, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+    * This function is run by the background thread. It sleeps whenever there's
+    * nothing to write.
+    */
+    void run()
+    {
+        while (true)
+        {
+            bool stop = stopping.load(std::memory_order_acquire);
+            if (writeMessages() == 0)
+            {
+                if (stop)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    /**
+    * This function starts the background thread the first time it's called.
+    */
+    void start()
+    {
+        std::call_once(start_flag, [] {
+            slots.reset(new Slot[Log::BUFFER_MESSAGES]);
+            for (std::size_t i = 0; i < Log::BUFFER_MESSAGES; i++)
+            {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            running = true;
+            writer = std::thread(run);
+        });
+    }
+
+    /**
+    * This struct writes out the remaining messages when the program exits. It's
+    * declared after everything else so that it's destroyed first.
+    */
+    struct ShutDownAtExit
+    {
+        ~ShutDownAtExit()
+        {
+            Log::shutDown();
+        }
+    } shut_down_at_exit;
+}
+
+/**
+* This function makes the logger write to a file instead of stdout. It returns
+* false if the file couldn't be opened, in which case stdout is still used.
+*/
+bool Log::setFile(const std::string& file_name)
+{
+    std::lock_guard<std::mutex> lock(output_mutex);
+    file.open(file_name, std::ios::out | std::ios::trunc);
+    output = file.is_open() ? static_cast<std::ostream*>(&file) : &std::cout;
+    return file.is_open();
+}
+
+/**
+* This function waits until every message logged so far has been written.
+*/
+void Log::flush()
+{
+    std::size_t position = enqueue_position.load(std::memory_order_acquire);
+    while (running && dequeue_position.load(std::memory_order_acquire) < position)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+/**
+* This function writes out the remaining messages and stops the background thread.
+* Messages logged after this are dropped.
+*/
+void Log::shutDown()
+{
+    if (running.exchange(false))
+    {
+        stopping = true;
+        writer.join();
+    }
+}
+
+/**
+* This function returns how many messages have been dropped because the buffer was full.
+*/
+std::uint64_t Log::getDroppedCount()
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+/**
+* This function reserves space for a message, and returns a stream that writes into
+* it. It returns nullptr if there is no space. "endMessage" must be called after.
+*/
+std::ostream* Log::beginMessage(const Severity severity)
+{
+    start();
+    if (!running.load(std::memory_order_relaxed))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // Claim the next slot. If the slot hasn't been written out since the last time
+    // around the buffer, the buffer is full.
+    std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+        slot = &slots[position & (BUFFER_MESSAGES - 1)];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (difference == 0)
+        {
+            if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else
+        {
+            position = enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    current_slot = slot;
+    current_position = position;
+    slot->severity = severity;
+    slot->time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+    slot_buffer.reset(slot->text, MESSAGE_SIZE);
+    slot_stream.clear();
+    return &slot_stream;
+}
+
+/**
+* This function hands the message started by "beginMessage" to the background thread.
+*/
+void Log::endMessage()
+{
+    current_slot->length = slot_buffer.getLength();
+    current_slot->sequence.store(current_position + 1, std::memory_order_release);
+}
\ No newline at end of file
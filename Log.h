@@ -0,0 +1,113 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <cstdint>
+
+#define LOG_SEVERITY_DEBUG 0
+#define LOG_SEVERITY_INFO 1
+#define LOG_SEVERITY_WARNING 2
+#define LOG_SEVERITY_ERROR 3
+#define LOG_SEVERITY_NONE 4
+
+// Messages less severe than this are compiled out. Set it to LOG_SEVERITY_NONE
+// if you don't want any output.
+#ifndef LOG_MINIMUM_SEVERITY
+#define LOG_MINIMUM_SEVERITY LOG_SEVERITY_INFO
+#endif
+
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_DEBUG
+#define LOG_DEBUG(out) Log::write(Log::Severity::Debug, [&](std::ostream& log_stream) { log_stream << out; })
+#else
+#define LOG_DEBUG(out)
+#endif
+
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_INFO
+#define LOG_INFO(out) Log::write(Log::Severity::Info, [&](std::ostream& log_stream) { log_stream << out; })
+#else
+#define LOG_INFO(out)
+#endif
+
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_WARNING
+#define LOG_WARNING(out) Log::write(Log::Severity::Warning, [&](std::ostream& log_stream) { log_stream << out; })
+#else
+#define LOG_WARNING(out)
+#endif
+
+#if LOG_MINIMUM_SEVERITY <= LOG_SEVERITY_ERROR
+#define LOG_ERROR(out) Log::write(Log::Severity::Error, [&](std::ostream& log_stream) { log_stream << out; })
+#else
+#define LOG_ERROR(out)
+#endif
+
+/**
+* This namespace holds the logger. Messages are formatted straight into a fixed size
+* ring buffer, and a background thread writes them out, so logging never waits on
+* the terminal or a file. Any thread can log. If the buffer is full the message is
+* dropped rather than waiting for space, and messages longer than MESSAGE_SIZE
+* are cut short.
+*
+* The background thread is started by the first message, and writes to stdout until
+* "setFile" is called. Anything still in the buffer is written when the program exits.
+*/
+namespace Log
+{
+    enum class Severity
+    {
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    const std::size_t MESSAGE_SIZE = 512;
+    const std::size_t BUFFER_MESSAGES = 4096;
+
+    /**
+    * This function makes the logger write to a file instead of stdout. It returns
+    * false if the file couldn't be opened, in which case stdout is still used.
+    */
+    bool setFile(const std::string& file_name);
+
+    /**
+    * This function waits until every message logged so far has been written.
+    */
+    void flush();
+
+    /**
+    * This function writes out the remaining messages and stops the background thread.
+    * Messages logged after this are dropped.
+    */
+    void shutDown();
+
+    /**
+    * This function returns how many messages have been dropped because the buffer was full.
+    */
+    std::uint64_t getDroppedCount();
+
+    /**
+    * This function reserves space for a message, and returns a stream that writes into
+    * it. It returns nullptr if there is no space. "endMessage" must be called after.
+    */
+    std::ostream* beginMessage(const Severity severity);
+
+    /**
+    * This function hands the message started by "beginMessage" to the background thread.
+    */
+    void endMessage();
+
+    /**
+    * This function logs a message. "format" is called with the stream to write the
+    * message to. The macros above should be used instead of calling this.
+    */
+    template <typename Format>
+    void write(const Severity severity, const Format& format)
+    {
+        std::ostream* stream = beginMessage(severity);
+        if (stream != nullptr)
+        {
+            format(*stream);
+            endMessage();
+        }
+    }
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "MainMenuState.h"
+#include "Input.h"
 
 MainMenuState::MainMenuState()
     : play_button("Resources/Fonts/GameFont.ttf", 24, "Play", 20, 20, false, { 255, 255, 255, 255 }),
@@ -17,56 +18,62 @@ void MainMenuState::startUp()
     SDL_FreeSurface(cursor_surface);
 
     click_sound = Application::getSound("Resources/Sounds/Click.wav");
+    canvas.invalidateAll();
 }
 
 void MainMenuState::handleEvents()
 {
-    if (Application::getEvent().type == SDL_MOUSEBUTTONDOWN)
+    if (Input::wasButtonPressed(SDL_BUTTON_LEFT))
     {
-        if (Application::getEvent().button.button == SDL_BUTTON_LEFT)
+        if (play_button.isBig())
         {
-            if (play_button.isBig())
-            {
-                Mix_PlayChannel(-1, click_sound, 0);
-                Application::changeState("GAME");
-            }
-            else if (options_button.isBig())
-            {
-                Mix_PlayChannel(-1, click_sound, 0);
-                Application::changeState("OPTIONS");
-            }
-            else if (quit_button.isBig())
-            {
-                Mix_PlayChannel(-1, click_sound, 0);
-                Application::quit();
-            }
+            Mix_PlayChannel(-1, click_sound, 0);
+            Application::changeState("GAME");
         }
-    }
-    else if (Application::getEvent().type == SDL_KEYDOWN)
-    {
-        if (Application::getEvent().key.keysym.sym == SDLK_ESCAPE)
+        else if (options_button.isBig())
+        {
+            Mix_PlayChannel(-1, click_sound, 0);
+            Application::changeState("OPTIONS");
+        }
+        else if (quit_button.isBig())
         {
+            Mix_PlayChannel(-1, click_sound, 0);
             Application::quit();
         }
     }
+    else if (Input::wasKeyPressed(SDLK_ESCAPE))
+    {
+        Application::quit();
+    }
 }
 
 void MainMenuState::update()
 {
-    play_button.update();
-    options_button.update();
-    quit_button.update();
-    title.draw();
+    // Only the buttons that change size are drawn again.
+    for (auto button : { &play_button, &options_button, &quit_button })
+    {
+        if (button->update())
+        {
+            canvas.invalidate(button->getRect());
+        }
+    }
 }
 
 void MainMenuState::draw()
 {
-    play_button.draw();
-    options_button.draw();
-    quit_button.draw();
-    title.draw();
+    canvas.draw([this] {
+        play_button.draw();
+        options_button.draw();
+        quit_button.draw();
+        title.draw();
+    });
 }
 
 void MainMenuState::shutDown()
 {
+}
+
+bool MainMenuState::isIdle()
+{
+    return true;
 }
\ No newline at end of file
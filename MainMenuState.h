@@ -2,6 +2,7 @@
 
 #include "Application.h"
 #include "Button.h"
+#include "MenuCanvas.h"
 
 class MainMenuState : public Application::BaseState
 {
@@ -12,13 +13,14 @@ public:
     void update();
     void draw();
     void shutDown();
+    bool isIdle();
 
 private:
     Button play_button;
     Button options_button;
     Button quit_button;
     Text title;
+    MenuCanvas canvas;
     SDL_Cursor* cursor;
     Mix_Chunk* click_sound;
 };
-
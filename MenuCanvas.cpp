@@ -0,0 +1,148 @@
+#include "MenuCanvas.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+
+/**
+* This anonymous namespace holds the canvas that was drawn last, which is the one
+* being shown.
+*/
+namespace
+{
+    MenuCanvas* current = nullptr;
+}
+
+MenuCanvas::~MenuCanvas()
+{
+    if (current == this)
+    {
+        current = nullptr;
+    }
+    RenderThread::call([this] {
+        if (texture != nullptr)
+        {
+            Compositor::removeImage(texture);
+            SDL_DestroyTexture(texture);
+        }
+    });
+}
+
+/**
+* This method marks part of the screen as needing to be drawn again.
+*/
+void MenuCanvas::invalidate(const SDL_Rect& rect)
+{
+    if (all_dirty || SDL_RectEmpty(&rect))
+    {
+        return;
+    }
+
+    // Too many small rects cost more than one big one, so they're joined together.
+    if (dirty_rects.size() >= MAXIMUM_DIRTY_RECTS)
+    {
+        for (std::size_t i = 1; i < dirty_rects.size(); i++)
+        {
+            SDL_UnionRect(&dirty_rects[0], &dirty_rects[i], &dirty_rects[0]);
+        }
+        dirty_rects.resize(1);
+        SDL_UnionRect(&dirty_rects[0], &rect, &dirty_rects[0]);
+        return;
+    }
+    dirty_rects.push_back(rect);
+}
+
+/**
+* This method marks the whole screen as needing to be drawn again.
+*/
+void MenuCanvas::invalidateAll()
+{
+    all_dirty = true;
+    dirty_rects.clear();
+}
+
+/**
+* This method draws the dirty parts of the menu with "draw_menu", and then
+* draws the menu to the screen.
+*/
+void MenuCanvas::draw(const std::function<void()>& draw_menu)
+{
+    current = this;
+    const SDL_Point& size = Application::getRenderSize();
+    if (failed)
+    {
+        draw_menu();
+        return;
+    }
+
+    if (all_dirty || !dirty_rects.empty())
+    {
+        RenderThread::call([&] {
+            SDL_Renderer* renderer = Application::getRenderer();
+            if (texture == nullptr)
+            {
+                texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+                if (texture == nullptr)
+                {
+                    LOG_WARNING("Couldn't create a menu canvas: " << SDL_GetError());
+                    failed = true;
+                    return;
+                }
+                SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+                all_dirty = true;
+            }
+            if (all_dirty)
+            {
+                dirty_rects.assign(1, { 0, 0, size.x, size.y });
+            }
+
+            Uint8 red, green, blue, alpha;
+            SDL_GetRenderDrawColor(renderer, &red, &green, &blue, &alpha);
+            SDL_SetRenderTarget(renderer, texture);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            for (const auto& dirty_rect : dirty_rects)
+            {
+                SDL_RenderSetClipRect(renderer, &dirty_rect);
+                SDL_RenderFillRect(renderer, &dirty_rect);
+                draw_menu();
+                Compositor::capture(texture, &dirty_rect);
+            }
+            SDL_RenderSetClipRect(renderer, nullptr);
+            SDL_SetRenderDrawColor(renderer, red, green, blue, alpha);
+            SDL_SetRenderTarget(renderer, nullptr);
+        });
+        dirty_rects.clear();
+        all_dirty = false;
+    }
+
+    if (failed)
+    {
+        draw_menu();
+        return;
+    }
+    Compositor::draw(texture, nullptr, { 0, 0, size.x, size.y });
+}
+
+/**
+* This function handles the events for when the renderer loses its textures, by
+* drawing the canvas that was drawn last again in full.
+*/
+void MenuCanvas::handleEvent(const SDL_Event& event)
+{
+    if (current == nullptr || (event.type != SDL_RENDER_TARGETS_RESET && event.type != SDL_RENDER_DEVICE_RESET))
+    {
+        return;
+    }
+
+    // When the whole device is reset, the texture has to be made again.
+    if (event.type == SDL_RENDER_DEVICE_RESET)
+    {
+        RenderThread::call([] {
+            if (current->texture != nullptr)
+            {
+                Compositor::removeImage(current->texture);
+                SDL_DestroyTexture(current->texture);
+                current->texture = nullptr;
+            }
+        });
+    }
+    current->invalidateAll();
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Application.h"
+#include <functional>
+
+/**
+* This class keeps a menu's last frame in a texture, so drawing the menu is one copy.
+* When something in the menu changes, the part of the screen it covers is marked as
+* dirty, and only the dirty parts are drawn again the next time the menu is drawn.
+* The menu is drawn by a function the canvas is given, and clipping keeps it to the
+* dirty part being drawn. Some renderers lose what was drawn to the texture, like
+* Direct3D when the window goes fullscreen, so the canvas being shown is drawn again
+* in full when that happens.
+*/
+class MenuCanvas
+{
+public:
+    MenuCanvas() = default;
+    ~MenuCanvas();
+
+    /**
+    * This method marks part of the screen as needing to be drawn again.
+    */
+    void invalidate(const SDL_Rect& rect);
+
+    /**
+    * This method marks the whole screen as needing to be drawn again.
+    */
+    void invalidateAll();
+
+    /**
+    * This method draws the dirty parts of the menu with "draw_menu", and then
+    * draws the menu to the screen.
+    */
+    void draw(const std::function<void()>& draw_menu);
+
+    /**
+    * This function handles the events for when the renderer loses its textures, by
+    * drawing the canvas that was drawn last again in full.
+    */
+    static void handleEvent(const SDL_Event& event);
+
+private:
+    static const int MAXIMUM_DIRTY_RECTS = 8;
+
+    SDL_Texture* texture = nullptr;
+    std::vector<SDL_Rect> dirty_rects;
+    bool all_dirty = true;
+
+    // If the texture can't be created, the menu is drawn straight to the screen.
+    bool failed = false;
+};
\ No newline at end of file
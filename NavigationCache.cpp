@@ -0,0 +1,172 @@
+#include "NavigationCache.h"
+
+/**
+* This method sets the cost of every tile, in rows, and throws away every field.
+* The costs must outlive this object.
+*/
+void NavigationCache::setCosts(const std::vector<Uint8>& costs, const int width, const int height)
+{
+    this->costs = &costs;
+    this->width = width;
+    this->height = height;
+    entries.clear();
+    lookup.clear();
+    memory = 0;
+}
+
+/**
+* This method sets how many bytes the fields can use.
+*/
+void NavigationCache::setBudget(const std::size_t budget)
+{
+    this->budget = budget;
+    evict();
+}
+
+/**
+* This method returns the field for a target tile, building it if it isn't cached.
+* The field can be thrown away by the next call, so it shouldn't be kept.
+*/
+NavigationField& NavigationCache::getField(const SDL_Point& target)
+{
+    Uint32 key = getKey(target);
+    auto found = lookup.find(key);
+    if (found != lookup.end())
+    {
+        // Move the field to the front, since it's now the most recently used.
+        entries.splice(entries.begin(), entries, found->second);
+        Entry& entry = entries.front();
+        if (entry.stale)
+        {
+            entry.field.build(target);
+            entry.stale = false;
+            rebuilds++;
+        }
+        else
+        {
+            hits++;
+        }
+        return entry.field;
+    }
+
+    // Reuse the least recently used field's memory if another field won't fit.
+    misses++;
+    if (!entries.empty() && memory + entries.back().memory > budget)
+    {
+        entries.splice(entries.begin(), entries, std::prev(entries.end()));
+        lookup.erase(entries.front().key);
+        memory -= entries.front().memory;
+        evictions++;
+    }
+    else
+    {
+        entries.emplace_front();
+        entries.front().field.setCosts(*costs, width, height);
+    }
+
+    Entry& entry = entries.front();
+    entry.key = key;
+    entry.stale = false;
+    entry.field.build(target);
+    entry.memory = entry.field.getMemory();
+    memory += entry.memory;
+    lookup[key] = entries.begin();
+    evict();
+    return entry.field;
+}
+
+/**
+* This method determines if the field for a target tile is cached.
+*/
+bool NavigationCache::hasField(const SDL_Point& target)
+{
+    return lookup.find(getKey(target)) != lookup.end();
+}
+
+/**
+* This method makes every field be built again the next time it's asked for. It
+* should be called after the costs have been changed.
+*/
+void NavigationCache::invalidate()
+{
+    for (auto& entry : entries)
+    {
+        entry.stale = true;
+    }
+}
+
+/**
+* This method returns how many fields are cached.
+*/
+std::size_t NavigationCache::size()
+{
+    return entries.size();
+}
+
+/**
+* This method returns how many bytes the fields use.
+*/
+std::size_t NavigationCache::getMemory()
+{
+    return memory;
+}
+
+/**
+* This method returns how many times a field was found in the cache.
+*/
+Uint64 NavigationCache::getHitCount()
+{
+    return hits;
+}
+
+/**
+* This method returns how many times a field wasn't found in the cache.
+*/
+Uint64 NavigationCache::getMissCount()
+{
+    return misses;
+}
+
+/**
+* This method returns how many times a field was built again after "invalidate".
+*/
+Uint64 NavigationCache::getRebuildCount()
+{
+    return rebuilds;
+}
+
+/**
+* This method returns how many fields have been thrown away to stay in the budget.
+*/
+Uint64 NavigationCache::getEvictionCount()
+{
+    return evictions;
+}
+
+/**
+* This method returns the key a target tile is cached under. Every tile outside the
+* level shares a key, since nothing can reach them.
+*/
+Uint32 NavigationCache::getKey(const SDL_Point& target)
+{
+    if (target.x < 0 || target.y < 0 || target.x >= width || target.y >= height)
+    {
+        return OUTSIDE_KEY;
+    }
+    return (target.y * width) + target.x;
+}
+
+/**
+* This method throws away the least recently used fields until the fields fit
+* in the budget.
+*/
+void NavigationCache::evict()
+{
+    while (entries.size() > 1 && memory > budget)
+    {
+        lookup.erase(entries.back().key);
+        memory -= entries.back().memory;
+        entries.pop_back();
+        evictions++;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "NavigationField.h"
+#include <list>
+#include <unordered_map>
+
+/**
+* This class holds a navigation field for each tile something is trying to get to, like
+* the player, a health pickup or a noise. Everything heading for the same tile shares
+* one field, and a field is only built the first time it's asked for.
+*
+* The fields are kept in order of when they were last used. When they use more memory
+* than the budget, the least recently used fields are thrown away, although the most
+* recently used one is always kept.
+*/
+class NavigationCache
+{
+public:
+    /**
+    * This method sets the cost of every tile, in rows, and throws away every field.
+    * The costs must outlive this object.
+    */
+    void setCosts(const std::vector<Uint8>& costs, const int width, const int height);
+
+    /**
+    * This method sets how many bytes the fields can use.
+    */
+    void setBudget(const std::size_t budget);
+
+    /**
+    * This method returns the field for a target tile, building it if it isn't cached.
+    * The field can be thrown away by the next call, so it shouldn't be kept.
+    */
+    NavigationField& getField(const SDL_Point& target);
+
+    /**
+    * This method determines if the field for a target tile is cached.
+    */
+    bool hasField(const SDL_Point& target);
+
+    /**
+    * This method makes every field be built again the next time it's asked for. It
+    * should be called after the costs have been changed.
+    */
+    void invalidate();
+
+    /**
+    * This method returns how many fields are cached.
+    */
+    std::size_t size();
+
+    /**
+    * This method returns how many bytes the fields use.
+    */
+    std::size_t getMemory();
+
+    /**
+    * This method returns how many times a field was found in the cache.
+    */
+    Uint64 getHitCount();
+
+    /**
+    * This method returns how many times a field wasn't found in the cache.
+    */
+    Uint64 getMissCount();
+
+    /**
+    * This method returns how many times a field was built again after "invalidate".
+    */
+    Uint64 getRebuildCount();
+
+    /**
+    * This method returns how many fields have been thrown away to stay in the budget.
+    */
+    Uint64 getEvictionCount();
+
+private:
+    /**
+    * This struct holds one cached field.
+    */
+    struct Entry
+    {
+        Uint32 key;
+        bool stale;
+        std::size_t memory;
+        NavigationField field;
+    };
+
+    /**
+    * This method returns the key a target tile is cached under. Every tile outside the
+    * level shares a key, since nothing can reach them.
+    */
+    Uint32 getKey(const SDL_Point& target);
+
+    /**
+    * This method throws away the least recently used fields until the fields fit
+    * in the budget.
+    */
+    void evict();
+
+private:
+    static constexpr Uint32 OUTSIDE_KEY = 0xFFFFFFFF;
+
+    const std::vector<Uint8>* costs = nullptr;
+    int width = 0;
+    int height = 0;
+    std::size_t budget = 0;
+    std::size_t memory = 0;
+
+    // The most recently used field is at the front of the list. The map finds a
+    // field's place in the list from its target tile.
+    std::list<Entry> entries;
+    std::unordered_map<Uint32, std::list<Entry>::iterator> lookup;
+
+    Uint64 hits = 0;
+    Uint64 misses = 0;
+    Uint64 rebuilds = 0;
+    Uint64 evictions = 0;
+};
\ No newline at end of file
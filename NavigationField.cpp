@@ -0,0 +1,206 @@
+#include "NavigationField.h"
+
+#include <algorithm>
+
+/**
+* This anonymous namespace holds the eight directions a tile can be left in. The first
+* four are straight, and the last four are diagonal. Each pair of directions are
+* opposites, so flipping the lowest bit of a direction reverses it.
+*/
+namespace
+{
+    const int DIRECTION_COUNT = 8;
+    const int DIRECTIONS[DIRECTION_COUNT][2] = {
+        { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+        { 1, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }
+    };
+}
+
+/**
+* This method sets the cost of every tile, in rows. A cost of 0 means the tile
+* can't be walked on. Any existing field is thrown away. The costs must outlive
+* this object.
+*/
+void NavigationField::setCosts(const std::vector<Uint8>& costs, const int width, const int height)
+{
+    this->costs = &costs;
+    this->width = width;
+    this->height = height;
+    distances.assign(width * height, UNREACHABLE);
+    directions.assign(width * height, NO_DIRECTION);
+
+    // A move costs its length times the average cost of the two tiles, so the most
+    // expensive move is a diagonal between two of the most expensive tiles. Every tile
+    // in the queue is within one move of the cheapest, so this many buckets is enough.
+    Uint32 maximum_cost = 1;
+    for (const auto& cost : costs)
+    {
+        maximum_cost = std::max(maximum_cost, static_cast<Uint32>(cost));
+    }
+    buckets.assign((DIAGONAL_COST * maximum_cost * 2) + 1, std::vector<Uint32>());
+}
+
+/**
+* This method builds the field for a target tile.
+*/
+void NavigationField::build(const SDL_Point& target)
+{
+    this->target = target;
+    version++;
+    std::fill(distances.begin(), distances.end(), UNREACHABLE);
+    std::fill(directions.begin(), directions.end(), NO_DIRECTION);
+    if (!isWalkable(target.x, target.y))
+    {
+        return;
+    }
+
+    const std::size_t BUCKET_COUNT = buckets.size();
+    Uint32 start = (target.y * width) + target.x;
+    distances[start] = 0;
+    buckets[0].push_back(start);
+    std::size_t queued = 1;
+
+    // Tiles are taken out of the buckets in order of distance. A tile can be in the
+    // buckets more than once if a cheaper path to it was found later, so stale entries
+    // are skipped.
+    for (Uint32 distance = 0; queued > 0; distance++)
+    {
+        std::vector<Uint32>& bucket = buckets[distance % BUCKET_COUNT];
+        while (!bucket.empty())
+        {
+            Uint32 tile = bucket.back();
+            bucket.pop_back();
+            queued--;
+            if (distances[tile] != distance)
+            {
+                continue;
+            }
+
+            int x = tile % width;
+            int y = tile / width;
+            for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+            {
+                int nx = x + DIRECTIONS[direction][0];
+                int ny = y + DIRECTIONS[direction][1];
+                if (!isWalkable(nx, ny))
+                {
+                    continue;
+                }
+
+                // Diagonal moves can only be made if both of the tiles next to the
+                // corner are clear.
+                bool diagonal = direction >= 4;
+                if (diagonal && (!isWalkable(nx, y) || !isWalkable(x, ny)))
+                {
+                    continue;
+                }
+
+                Uint32 neighbour = (ny * width) + nx;
+                Uint32 new_distance = distance + ((diagonal ? DIAGONAL_COST : STRAIGHT_COST) * ((*costs)[tile] + (*costs)[neighbour]));
+                if (new_distance < distances[neighbour])
+                {
+                    // The neighbour's next tile is this tile, which is the opposite
+                    // direction to the one just moved in.
+                    distances[neighbour] = new_distance;
+                    directions[neighbour] = static_cast<Sint8>(direction ^ 1);
+                    buckets[new_distance % BUCKET_COUNT].push_back(neighbour);
+                    queued++;
+                }
+            }
+        }
+    }
+}
+
+/**
+* This method returns the tile the field leads to.
+*/
+const SDL_Point& NavigationField::getTarget()
+{
+    return target;
+}
+
+/**
+* This method determines if the target can be reached from a tile.
+*/
+bool NavigationField::isReachable(const SDL_Point& tile)
+{
+    return getDistance(tile) != UNREACHABLE;
+}
+
+/**
+* This method returns the cost of the cheapest path from a tile to the target.
+* Straight moves over tiles with a cost of 1 cost STRAIGHT_COST * 2.
+*/
+Uint32 NavigationField::getDistance(const SDL_Point& tile)
+{
+    if (tile.x < 0 || tile.y < 0 || tile.x >= width || tile.y >= height)
+    {
+        return UNREACHABLE;
+    }
+    return distances[(tile.y * width) + tile.x];
+}
+
+/**
+* This method returns the next tile on the cheapest path from a tile to the target.
+*/
+SDL_Point NavigationField::getNextTile(const SDL_Point& tile)
+{
+    if (!isReachable(tile) || (tile.x == target.x && tile.y == target.y))
+    {
+        return tile;
+    }
+
+    Sint8 direction = directions[(tile.y * width) + tile.x];
+    return { tile.x + DIRECTIONS[direction][0], tile.y + DIRECTIONS[direction][1] };
+}
+
+/**
+* This method returns a deque of each tile from the target to "tile", or an empty
+* deque if the target can't be reached.
+*/
+std::deque<SDL_Point> NavigationField::getPath(const SDL_Point& tile)
+{
+    std::deque<SDL_Point> path;
+    if (!isReachable(tile))
+    {
+        return path;
+    }
+
+    SDL_Point current = tile;
+    path.push_front(current);
+    while (current.x != target.x || current.y != target.y)
+    {
+        current = getNextTile(current);
+        path.push_front(current);
+    }
+    return path;
+}
+
+/**
+* This method returns how many times the field has been built.
+*/
+int NavigationField::getVersion()
+{
+    return version;
+}
+
+/**
+* This method returns how many bytes the field uses.
+*/
+std::size_t NavigationField::getMemory()
+{
+    std::size_t memory = (distances.capacity() * sizeof(Uint32)) + (directions.capacity() * sizeof(Sint8));
+    for (const auto& bucket : buckets)
+    {
+        memory += sizeof(bucket) + (bucket.capacity() * sizeof(Uint32));
+    }
+    return memory;
+}
+
+/**
+* This method determines if a tile is in the level and can be walked on.
+*/
+bool NavigationField::isWalkable(const int x, const int y)
+{
+    return x >= 0 && y >= 0 && x < width && y < height && (*costs)[(y * width) + x] != 0;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Application.h"
+#include <deque>
+
+/**
+* This class holds the cheapest way to reach one target tile from every other tile in a
+* level. Each tile has a cost for walking over it, and solid tiles have a cost of 0.
+* Moving diagonally costs about 1.4 times as much as moving straight, and diagonal moves
+* can't cut across the corner of a solid tile.
+*
+* The field is built with Dial's algorithm, which is Dijkstra's algorithm with a bucket
+* for each possible distance instead of a heap. Costs are small integers, so there are
+* only a few buckets and building the field takes time close to linear in the number
+* of tiles.
+*/
+class NavigationField
+{
+public:
+    /**
+    * This method sets the cost of every tile, in rows. A cost of 0 means the tile
+    * can't be walked on. Any existing field is thrown away. The costs must outlive
+    * this object.
+    */
+    void setCosts(const std::vector<Uint8>& costs, const int width, const int height);
+
+    /**
+    * This method builds the field for a target tile.
+    */
+    void build(const SDL_Point& target);
+
+    /**
+    * This method returns the tile the field leads to.
+    */
+    const SDL_Point& getTarget();
+
+    /**
+    * This method determines if the target can be reached from a tile.
+    */
+    bool isReachable(const SDL_Point& tile);
+
+    /**
+    * This method returns the cost of the cheapest path from a tile to the target.
+    * Straight moves over tiles with a cost of 1 cost STRAIGHT_COST * 2.
+    */
+    Uint32 getDistance(const SDL_Point& tile);
+
+    /**
+    * This method returns the next tile on the cheapest path from a tile to the target.
+    */
+    SDL_Point getNextTile(const SDL_Point& tile);
+
+    /**
+    * This method returns a deque of each tile from the target to "tile", or an empty
+    * deque if the target can't be reached.
+    */
+    std::deque<SDL_Point> getPath(const SDL_Point& tile);
+
+    /**
+    * This method returns how many times the field has been built.
+    */
+    int getVersion();
+
+    /**
+    * This method returns how many bytes the field uses.
+    */
+    std::size_t getMemory();
+
+public:
+    static constexpr Uint32 STRAIGHT_COST = 5;
+    static constexpr Uint32 DIAGONAL_COST = 7;
+    static constexpr Uint32 UNREACHABLE = 0xFFFFFFFF;
+
+private:
+    /**
+    * This method determines if a tile is in the level and can be walked on.
+    */
+    bool isWalkable(const int x, const int y);
+
+private:
+    static constexpr Sint8 NO_DIRECTION = -1;
+
+    const std::vector<Uint8>* costs = nullptr;
+    int width = 0;
+    int height = 0;
+    SDL_Point target = { 0, 0 };
+    int version = 0;
+
+    // For each tile, the distance to the target and the direction of the next tile.
+    std::vector<Uint32> distances;
+    std::vector<Sint8> directions;
+
+    // The buckets are reused by every build. Bucket "d % buckets.size()" holds the
+    // tiles that might be "d" away from the target.
+    std::vector<std::vector<Uint32>> buckets;
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "OptionsMenuState.h"
+#include "Input.h"
 
 OptionsMenuState::OptionsMenuState()
     : back_button("Resources/Fonts/GameFont.ttf", 24, "Back", 20, 20, false, { 255, 255, 255, 255 }),
@@ -21,31 +22,33 @@ void OptionsMenuState::startUp()
     cursor = SDL_CreateColorCursor(cursor_surface, 0, 0);
     SDL_SetCursor(cursor);
     SDL_FreeSurface(cursor_surface);
+    canvas.invalidateAll();
 }
 
 void OptionsMenuState::handleEvents()
 {
-    if (Application::getEvent().type == SDL_KEYDOWN)
+    if (Input::wasKeyPressed(SDLK_ESCAPE))
     {
-        if (Application::getEvent().key.keysym.sym == SDLK_ESCAPE)
+        Application::changeState("MAIN");
+    }
+    else if (Input::wasButtonPressed(SDL_BUTTON_LEFT))
+    {
+        if (back_button.isBig())
         {
+            Mix_PlayChannel(-1, click_sound, 0);
             Application::changeState("MAIN");
         }
-    }
-    else if (Application::getEvent().type == SDL_MOUSEBUTTONDOWN)
-    {
-        if (Application::getEvent().button.button == SDL_BUTTON_LEFT)
+        else
         {
-            if (back_button.isBig())
-            {
-                Mix_PlayChannel(-1, click_sound, 0);
-                Application::changeState("MAIN");
-            }
-            else
+            // A list covers a different part of the screen once its option changes.
+            for (auto list : { &fullscreen, &resolution, &volume })
             {
-                fullscreen.pressed();
-                resolution.pressed();
-                volume.pressed();
+                SDL_Rect old_rect = list->getRect();
+                if (list->pressed())
+                {
+                    canvas.invalidate(old_rect);
+                    canvas.invalidate(list->getRect());
+                }
             }
         }
     }
@@ -53,7 +56,10 @@ void OptionsMenuState::handleEvents()
 
 void OptionsMenuState::update()
 {
-    back_button.update();
+    if (back_button.update())
+    {
+        canvas.invalidate(back_button.getRect());
+    }
     fullscreen.update();
     resolution.update();
     volume.update();
@@ -61,11 +67,13 @@ void OptionsMenuState::update()
 
 void OptionsMenuState::draw()
 {
-    back_button.draw();
-    fullscreen.draw();
-    resolution.draw();
-    volume.draw();
-    instructions.draw();
+    canvas.draw([this] {
+        back_button.draw();
+        fullscreen.draw();
+        resolution.draw();
+        volume.draw();
+        instructions.draw();
+    });
 }
 
 void OptionsMenuState::shutDown()
@@ -97,4 +105,9 @@ void OptionsMenuState::shutDown()
     }
 
     Application::writeConfig();
+}
+
+bool OptionsMenuState::isIdle()
+{
+    return true;
 }
\ No newline at end of file
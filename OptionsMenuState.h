@@ -3,6 +3,7 @@
 #include "Application.h"
 #include "Button.h"
 #include "SelectionList.h"
+#include "MenuCanvas.h"
 #include "Tools.h"
 
 class OptionsMenuState : public Application::BaseState
@@ -14,6 +15,7 @@ public:
     void update();
     void draw();
     void shutDown();
+    bool isIdle();
 
 private:
     Button back_button;
@@ -21,7 +23,7 @@ private:
     SelectionList resolution;
     SelectionList volume;
     Text instructions;
+    MenuCanvas canvas;
     SDL_Cursor* cursor;
     Mix_Chunk* click_sound;
 };
-
@@ -1,5 +1,7 @@
 #include "Player.h"
-#include "Enemy.h"
+#include "Compositor.h"
+#include "Level.h"
+#include "Input.h"
 
 Player::Player() : health_counter(Application::getFont("Resources/Fonts/GameFont.ttf", 24), "", 20, 20, false, { 255, 255, 255, 255 }),
                    ammo_counter(Application::getFont("Resources/Fonts/GameFont.ttf", 24), "", Application::getRenderSize().x - 150, 20, false, { 255, 255, 255, 255 })
@@ -65,24 +67,36 @@ void Player::draw()
     draw_rect.y = rect.y;
     draw_rect = Application::applyCamera(draw_rect);
 
-    SDL_RenderCopyEx(Application::getRenderer(), current_texture, nullptr, &draw_rect, angle, nullptr, SDL_FLIP_NONE);
+    // The mouse is read again just before drawing, so the player is drawn facing
+    // where the mouse is now. This only changes how the player looks.
+    int draw_angle = angle;
+    if (mouse_aim)
+    {
+        const SDL_Point& mouse_position = Input::sampleMouse();
+        draw_angle = getAimAngle({ mouse_position.x - Application::getCamera().x, mouse_position.y - Application::getCamera().y });
+    }
+    SpriteCache::draw(current_texture, draw_rect, draw_angle);
+}
+
+/**
+* This method draws the player's health, ammo and weapon to the screen.
+*/
+void Player::drawHUD()
+{
     health_counter.draw();
     ammo_counter.draw();
-    SDL_RenderCopy(Application::getRenderer(), weapon_texture, nullptr, &weapon_rect);
+    Compositor::draw(weapon_texture, nullptr, weapon_rect);
 }
 
 /**
 * This method updates the player. It moves the player, handles all player
 * collisions and makes the player look towards the mouse.
 */
-void Player::update(Level& level, std::vector<std::shared_ptr<Enemy>>& enemies, std::vector<Projectile>& player_projectiles)
+void Player::update(Level& level, const std::vector<SDL_Rect>& enemy_rects, std::vector<Projectile>& player_projectiles)
 {
     // Create a vector of all solids the player will encounter.
     std::vector<SDL_Rect> solids = level.getSurroundingSolids((rect.x + (rect.w / 2)) / level.TILE_SIZE, (rect.y + (rect.h / 2)) / level.TILE_SIZE);
-    for (auto& enemy : enemies)
-    {
-        solids.push_back(enemy->getRect());
-    }
+    solids.insert(solids.end(), enemy_rects.begin(), enemy_rects.end());
 
     // Movement and collisions on the X axis.
     rect.x += static_cast<int>(std::round(movement.x * Application::getDeltaTime()));
@@ -118,13 +132,15 @@ void Player::update(Level& level, std::vector<std::shared_ptr<Enemy>>& enemies,
         }
     }
 
-    // Make the player face the mouse.
-    angle = Tools::angleBetweenPoints(
-        rect.x + (rect.w / 2),
-        rect.y + (rect.h / 2),
-        Application::getMousePosition().x - Application::getCamera().x,
-        Application::getMousePosition().y - Application::getCamera().y
-    ) - 180;
+    // Make the player face the mouse, or the point it has been told to aim at. The
+    // mouse is read again here, rather than using where it was at the start of the frame.
+    if (mouse_aim)
+    {
+        const SDL_Point& mouse_position = Input::sampleMouse();
+        aim_point.x = mouse_position.x - Application::getCamera().x;
+        aim_point.y = mouse_position.y - Application::getCamera().y;
+    }
+    angle = getAimAngle(aim_point);
 
     // Set the camera to the position of the player.
     Application::getCamera().x = (Application::getRenderSize().x / 2) - rect.x;
@@ -149,49 +165,13 @@ void Player::update(Level& level, std::vector<std::shared_ptr<Enemy>>& enemies,
 }
 
 /**
-* This method handles all key presses related to the player. It mostly
-* handles movement key presses.
+* This method sets the direction the player moves in from the movement keys
+* that are down. Opposite keys cancel each other out.
 */
-void Player::handleKeyPresses()
+void Player::handleInput()
 {
-    switch (Application::getEvent().key.keysym.sym)
-    {
-    case SDLK_a:
-        movement.x = -SPEED;
-        break;
-    case SDLK_d:
-        movement.x = SPEED;
-        break;
-    case SDLK_w:
-        movement.y = -SPEED;
-        break;
-    case SDLK_s:
-        movement.y = SPEED;
-        break;
-    default:
-        break;
-    }
-}
-
-/**
-* This method handles all key releases related to the player. It mostly
-* handles releases key presses.
-*/
-void Player::handleKeyReleases()
-{
-    switch (Application::getEvent().key.keysym.sym)
-    {
-    case SDLK_a:
-    case SDLK_d:
-        movement.x = 0;
-        break;
-    case SDLK_w:
-    case SDLK_s:
-        movement.y = 0;
-        break;
-    default:
-        break;
-    }
+    movement.x = (Input::isKeyDown(SDLK_d) - Input::isKeyDown(SDLK_a)) * SPEED;
+    movement.y = (Input::isKeyDown(SDLK_s) - Input::isKeyDown(SDLK_w)) * SPEED;
 }
 
 /**
@@ -219,6 +199,14 @@ void Player::damage(const int damage)
     health_counter.setText("Health: " + std::to_string(health));
 }
 
+/**
+* This method returns the player's health.
+*/
+int Player::getHealth()
+{
+    return health;
+}
+
 /**
 * This method determines if the player is dead.
 */
@@ -244,12 +232,12 @@ int Player::getAngle()
 }
 
 /**
-* This method changes the current weapon depending on how much the player
-* has scrolled using the scroll wheel.
+* This method changes the current weapon. "amount" is how many weapons to move
+* along by, which is how much the player has scrolled using the scroll wheel.
 */
-void Player::changeWeapon()
+void Player::changeWeapon(const int amount)
 {
-    weapon_index += Application::getEvent().wheel.y;
+    weapon_index += amount;
     if (weapon_index < 0)
     {
         weapon_index = weapons.size() - 1;
@@ -272,6 +260,41 @@ void Player::changeWeapon()
     SDL_QueryTexture(current_texture, nullptr, nullptr, &draw_rect.w, &draw_rect.h);
 }
 
+/**
+* This method determines if the current weapon has any ammo left.
+*/
+bool Player::hasAmmo()
+{
+    return ammo[current_weapon] > 0;
+}
+
+/**
+* This method sets the direction the player moves in, without any key presses.
+* Each axis should be -1, 0 or 1.
+*/
+void Player::setMovement(const int x, const int y)
+{
+    movement.x = x * SPEED;
+    movement.y = y * SPEED;
+}
+
+/**
+* This method makes the player face a point in the level instead of the mouse.
+*/
+void Player::aimAt(const SDL_Point& point)
+{
+    mouse_aim = false;
+    aim_point = point;
+}
+
+/**
+* This method makes the player face the mouse again.
+*/
+void Player::aimWithMouse()
+{
+    mouse_aim = true;
+}
+
 /**
 * This method adds ammo to the ammo count of the weapon. It returns
 * whether or not any ammo has been added.
@@ -361,4 +384,17 @@ bool Player::canShoot()
         }
     }
     return false;
+}
+
+/**
+* This method returns the angle the player faces to look at a point in the level.
+*/
+int Player::getAimAngle(const SDL_Point& point)
+{
+    return Tools::angleBetweenPoints(
+        rect.x + (rect.w / 2),
+        rect.y + (rect.h / 2),
+        point.x,
+        point.y
+    ) - 180;
 }
\ No newline at end of file
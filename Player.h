@@ -7,7 +7,6 @@
 #include "Projectile.h"
 
 class Level;
-class Enemy;
 
 /**
 * This class represents the player. It handles everything directly related
@@ -36,22 +35,21 @@ public:
     void draw();
 
     /**
-    * This method updates the player. It moves the player, handles all player
-    * collisions and makes the player look towards the mouse.
+    * This method draws the player's health, ammo and weapon to the screen.
     */
-    void update(Level& level, std::vector<std::shared_ptr<Enemy>>& enemies, std::vector<Projectile>& player_projectiles);
+    void drawHUD();
 
     /**
-    * This method handles all key presses related to the player. It mostly
-    * handles movement key presses.
+    * This method updates the player. It moves the player, handles all player
+    * collisions and makes the player look towards the mouse.
     */
-    void handleKeyPresses();
+    void update(Level& level, const std::vector<SDL_Rect>& enemy_rects, std::vector<Projectile>& player_projectiles);
 
     /**
-    * This method handles all key releases related to the player. It mostly
-    * handles releases key presses.
+    * This method sets the direction the player moves in from the movement keys
+    * that are down. Opposite keys cancel each other out.
     */
-    void handleKeyReleases();
+    void handleInput();
 
     /**
     * This method returns an SDL_Point of the centre of the player.
@@ -68,6 +66,11 @@ public:
     */
     void damage(const int damage);
 
+    /**
+    * This method returns the player's health.
+    */
+    int getHealth();
+
     /**
     * This method determines if the player is dead.
     */
@@ -84,10 +87,31 @@ public:
     int getAngle();
 
     /**
-    * This method changes the current weapon depending on how much the player
-    * has scrolled using the scroll wheel.
+    * This method changes the current weapon. "amount" is how many weapons to move
+    * along by, which is how much the player has scrolled using the scroll wheel.
+    */
+    void changeWeapon(const int amount);
+
+    /**
+    * This method determines if the current weapon has any ammo left.
+    */
+    bool hasAmmo();
+
+    /**
+    * This method sets the direction the player moves in, without any key presses.
+    * Each axis should be -1, 0 or 1.
+    */
+    void setMovement(const int x, const int y);
+
+    /**
+    * This method makes the player face a point in the level instead of the mouse.
     */
-    void changeWeapon();
+    void aimAt(const SDL_Point& point);
+
+    /**
+    * This method makes the player face the mouse again.
+    */
+    void aimWithMouse();
 
     /**
     * This method adds ammo to the ammo count of the weapon. It returns
@@ -122,6 +146,11 @@ private:
     */
     bool canShoot();
 
+    /**
+    * This method returns the angle the player faces to look at a point in the level.
+    */
+    int getAimAngle(const SDL_Point& point);
+
 private:
     static const int SPEED = 250;
     static const int MAX_HEALTH = 100;
@@ -146,6 +175,8 @@ private:
 
     int angle;
     int health;
+    bool mouse_aim = true;
+    SDL_Point aim_point;
 
     Text health_counter;
     Text ammo_counter;
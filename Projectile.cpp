@@ -26,7 +26,7 @@ Projectile::Projectile(const Weapon& weapon, const SDL_Point& start, const int d
 void Projectile::draw()
 {
     SDL_Rect draw_rect = Application::applyCamera(rect);
-    SDL_RenderCopyEx(Application::getRenderer(), texture, nullptr, &draw_rect, angle, nullptr, SDL_FLIP_NONE);
+    SpriteCache::draw(texture, draw_rect, angle);
 }
 
 /**
@@ -3,6 +3,7 @@
 #include "Application.h"
 #include "Tools.h"
 #include "Weapons.h"
+#include "SpriteCache.h"
 
 /**
 * This class represents every projectile in the game. Each projectile
@@ -0,0 +1,273 @@
+#include "Random.h"
+
+#include <atomic>
+#include <chrono>
+
+/**
+* This namespace contains the game's random number generators. Every generator can be
+* seeded, and each system and thread gets its own stream so that they never share state.
+*/
+namespace Random
+{
+    /**
+    * This anonymous namespace holds the seed and the system streams.
+    */
+    namespace
+    {
+        std::atomic<Uint64> current_seed(static_cast<Uint64>(std::chrono::system_clock::now().time_since_epoch().count()));
+        Generator streams[static_cast<int>(Stream::Count)];
+
+        // Every call to "seed" increments the generation, which tells threads to reseed their streams.
+        std::atomic<Uint32> seed_generation(0);
+        std::atomic<Uint32> thread_count(0);
+
+        /**
+        * This function returns the next value of a splitmix64 sequence. It is used to
+        * spread a seed over the state of a generator.
+        */
+        Uint64 splitMix(Uint64& x)
+        {
+            Uint64 z = (x += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        Uint32 rotateLeft(const Uint32 x, const int k)
+        {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        /**
+        * This function creates the streams from the current seed. Stream "n" is the
+        * seeded generator jumped "n" times.
+        */
+        void seedStreams()
+        {
+            Generator generator(current_seed);
+            for (auto& stream : streams)
+            {
+                stream = generator;
+                generator.jump();
+            }
+        }
+
+        /**
+        * This struct initializes the streams before the game starts, so the
+        * game is random even if "seed" is never called.
+        */
+        struct StreamInitializer
+        {
+            StreamInitializer()
+            {
+                seedStreams();
+            }
+        } stream_initializer;
+    }
+
+    Generator::Generator(const Uint64 seed)
+    {
+        this->seed(seed);
+    }
+
+    /**
+    * This method seeds the generator. The state is filled using splitmix64,
+    * so any seed (including 0) is fine.
+    */
+    void Generator::seed(const Uint64 seed)
+    {
+        Uint64 x = seed;
+        Uint64 a = splitMix(x);
+        Uint64 b = splitMix(x);
+        state[0] = static_cast<Uint32>(a);
+        state[1] = static_cast<Uint32>(a >> 32);
+        state[2] = static_cast<Uint32>(b);
+        state[3] = static_cast<Uint32>(b >> 32);
+    }
+
+    /**
+    * This method returns the next 32 random bits.
+    */
+    Uint32 Generator::next()
+    {
+        const Uint32 result = rotateLeft(state[1] * 5, 7) * 9;
+        const Uint32 t = state[1] << 9;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 11);
+
+        return result;
+    }
+
+    /**
+    * This method returns a random int between "from" and "to", inclusive.
+    */
+    int Generator::nextInt(const int from, const int to)
+    {
+        // Lemire's method maps the random bits onto the range with a multiply instead of
+        // a division, and only divides when a sample has to be rejected to avoid bias.
+        const Uint32 range = static_cast<Uint32>(to) - static_cast<Uint32>(from) + 1;
+        if (range == 0)
+        {
+            return static_cast<int>(next());
+        }
+
+        Uint64 m = static_cast<Uint64>(next()) * range;
+        Uint32 low = static_cast<Uint32>(m);
+        if (low < range)
+        {
+            const Uint32 threshold = (0u - range) % range;
+            while (low < threshold)
+            {
+                m = static_cast<Uint64>(next()) * range;
+                low = static_cast<Uint32>(m);
+            }
+        }
+
+        return static_cast<int>(static_cast<Uint32>(from) + static_cast<Uint32>(m >> 32));
+    }
+
+    /**
+    * This method returns a random float between "from" and "to".
+    */
+    float Generator::nextFloat(const float from, const float to)
+    {
+        // The top 24 bits fill the mantissa of a float in [0, 1).
+        const float unit = (next() >> 8) * (1.0f / 16777216.0f);
+        return from + (unit * (to - from));
+    }
+
+    /**
+    * This method fills "out" with "count" random ints between "from" and "to", inclusive.
+    */
+    void Generator::fillInts(int* out, const std::size_t count, const int from, const int to)
+    {
+        const Uint32 range = static_cast<Uint32>(to) - static_cast<Uint32>(from) + 1;
+
+        // Working on a local copy keeps the state in registers for the whole batch.
+        Generator generator = *this;
+        if (range == 0)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[i] = static_cast<int>(generator.next());
+            }
+        }
+        else
+        {
+            // The rejection threshold only needs working out once for the whole batch.
+            const Uint32 threshold = (0u - range) % range;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                Uint64 m = static_cast<Uint64>(generator.next()) * range;
+                while (static_cast<Uint32>(m) < threshold)
+                {
+                    m = static_cast<Uint64>(generator.next()) * range;
+                }
+                out[i] = static_cast<int>(static_cast<Uint32>(from) + static_cast<Uint32>(m >> 32));
+            }
+        }
+        *this = generator;
+    }
+
+    /**
+    * This method fills "out" with "count" random floats between "from" and "to".
+    */
+    void Generator::fillFloats(float* out, const std::size_t count, const float from, const float to)
+    {
+        const float scale = (to - from) * (1.0f / 16777216.0f);
+
+        Generator generator = *this;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            out[i] = from + ((generator.next() >> 8) * scale);
+        }
+        *this = generator;
+    }
+
+    /**
+    * This method advances the generator by 2^64 numbers. Jumping a copy of a generator
+    * gives a stream that will never overlap with the original.
+    */
+    void Generator::jump()
+    {
+        static const Uint32 JUMP[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+        Uint32 jumped[4] = { 0, 0, 0, 0 };
+        for (const auto& word : JUMP)
+        {
+            for (int bit = 0; bit < 32; bit++)
+            {
+                if (word & (1u << bit))
+                {
+                    for (int i = 0; i < 4; i++)
+                    {
+                        jumped[i] ^= state[i];
+                    }
+                }
+                next();
+            }
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            state[i] = jumped[i];
+        }
+    }
+
+    /**
+    * This function seeds every stream. The streams are jumped apart from each other,
+    * so they are independent but all determined by the one seed.
+    */
+    void seed(const Uint64 seed)
+    {
+        current_seed = seed;
+        seedStreams();
+        seed_generation++;
+    }
+
+    /**
+    * This function returns the seed the streams were last seeded with.
+    */
+    Uint64 getSeed()
+    {
+        return current_seed;
+    }
+
+    /**
+    * This function returns the stream for a system. System streams are not thread safe,
+    * and must only be used from the game thread.
+    */
+    Generator& getStream(const Stream stream)
+    {
+        return streams[static_cast<int>(stream)];
+    }
+
+    /**
+    * This function returns the stream for the calling thread. Each thread gets its own
+    * stream the first time it calls this, and it is reseeded whenever "seed" is called.
+    */
+    Generator& getThreadStream()
+    {
+        thread_local Generator generator;
+        thread_local Uint32 generation = ~0u;
+        thread_local Uint32 thread_index = thread_count++;
+
+        // Thread streams start after the system streams, so they never overlap with them.
+        if (generation != seed_generation)
+        {
+            generation = seed_generation;
+            generator.seed(current_seed);
+            for (Uint32 i = 0; i < static_cast<Uint32>(Stream::Count) + thread_index; i++)
+            {
+                generator.jump();
+            }
+        }
+
+        return generator;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+
+/**
+* This namespace contains the game's random number generators. Every generator can be
+* seeded, and each system and thread gets its own stream so that they never share state.
+*/
+namespace Random
+{
+    /**
+    * This class is a xoshiro128** generator. It is small, fast and produces
+    * good quality 32 bit numbers.
+    */
+    class Generator
+    {
+    public:
+        Generator(const Uint64 seed = 0);
+
+        /**
+        * This method seeds the generator. The state is filled using splitmix64,
+        * so any seed (including 0) is fine.
+        */
+        void seed(const Uint64 seed);
+
+        /**
+        * This method returns the next 32 random bits.
+        */
+        Uint32 next();
+
+        /**
+        * This method returns a random int between "from" and "to", inclusive.
+        */
+        int nextInt(const int from, const int to);
+
+        /**
+        * This method returns a random float between "from" and "to".
+        */
+        float nextFloat(const float from, const float to);
+
+        /**
+        * This method fills "out" with "count" random ints between "from" and "to", inclusive.
+        */
+        void fillInts(int* out, const std::size_t count, const int from, const int to);
+
+        /**
+        * This method fills "out" with "count" random floats between "from" and "to".
+        */
+        void fillFloats(float* out, const std::size_t count, const float from, const float to);
+
+        /**
+        * This method advances the generator by 2^64 numbers. Jumping a copy of a generator
+        * gives a stream that will never overlap with the original.
+        */
+        void jump();
+
+    private:
+        Uint32 state[4];
+    };
+
+    /**
+    * This enum contains every system that has its own stream. Only the simulation stream
+    * affects the outcome of the game, so it is the only one replays depend on.
+    */
+    enum class Stream
+    {
+        Simulation,
+        Cosmetic,
+        Count
+    };
+
+    /**
+    * This function seeds every stream. The streams are jumped apart from each other,
+    * so they are independent but all determined by the one seed.
+    */
+    void seed(const Uint64 seed);
+
+    /**
+    * This function returns the seed the streams were last seeded with.
+    */
+    Uint64 getSeed();
+
+    /**
+    * This function returns the stream for a system. System streams are not thread safe,
+    * and must only be used from the game thread.
+    */
+    Generator& getStream(const Stream stream);
+
+    /**
+    * This function returns the stream for the calling thread. Each thread gets its own
+    * stream the first time it calls this, and it is reseeded whenever "seed" is called.
+    */
+    Generator& getThreadStream();
+}
\ No newline at end of file
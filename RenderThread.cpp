@@ -0,0 +1,317 @@
+#include "RenderThread.h"
+#include "Compositor.h"
+#include "DynamicResolution.h"
+#include "Input.h"
+#include "SpriteCache.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+* This namespace runs all of the renderer's work on its own thread, so a frame can be
+* drawn while the next one is being updated. While a state draws, its draws are recorded
+* into a draw list instead of being done straight away. When the frame is finished, the
+* list is handed to the render thread, and the next frame is recorded into the other list.
+* The game thread only waits if the render thread is still drawing the frame before, so
+* frames are shown at most one frame late.
+*
+* Anything else that uses the renderer, like loading a texture, is run on the render
+* thread with "call", in order with the frames that were handed over before it. A texture
+* that has been drawn must not be destroyed until the frame it was drawn in has finished.
+*
+* When the render thread isn't running, everything is done straight away on the calling
+* thread, as before.
+*/
+namespace RenderThread
+{
+    /**
+    * This anonymous namespace holds the two draw lists and the queue of work for the
+    * render thread.
+    */
+    namespace
+    {
+        enum class CommandType
+        {
+            Draw,
+            Rotated,
+            BeginWorld,
+            EndWorld
+        };
+
+        /**
+        * This struct holds one recorded draw. The rects have already had the camera
+        * applied to them. "scale" is only used to begin the world.
+        */
+        struct Command
+        {
+            CommandType type;
+            SDL_Texture* texture;
+            SDL_Rect source_rect;
+            SDL_Rect destination_rect;
+            double angle;
+            SDL_RendererFlip flip;
+            bool whole_texture;
+            float scale;
+        };
+
+        // The game thread records into one list while the render thread draws the other.
+        std::vector<Command> draw_lists[2];
+        int recording_list = 0;
+        std::size_t draw_count = 0;
+
+        // Frames and calls are done in the order they're added. Each job is numbered,
+        // so anything can wait for a job to be done.
+        std::thread thread;
+        std::thread::id thread_id;
+        std::mutex mutex;
+        std::condition_variable job_added;
+        std::condition_variable job_done;
+        std::deque<std::function<void()>> jobs;
+        Uint64 added_count = 0;
+        Uint64 done_count = 0;
+        Uint64 last_frame = 0;
+        bool running = false;
+        bool stopping = false;
+
+        /**
+        * This function is run by the render thread. It does jobs until it's stopped
+        * and there are none left.
+        */
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                job_added.wait(lock, [] { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                {
+                    return;
+                }
+
+                std::function<void()> job = std::move(jobs.front());
+                jobs.pop_front();
+                lock.unlock();
+                job();
+                lock.lock();
+
+                done_count++;
+                job_done.notify_all();
+            }
+        }
+
+        /**
+        * This function adds a job for the render thread, and returns its number.
+        */
+        Uint64 addJob(std::function<void()> job)
+        {
+            Uint64 number;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobs.push_back(std::move(job));
+                number = ++added_count;
+            }
+            job_added.notify_one();
+            return number;
+        }
+
+        /**
+        * This function waits until a job has been done.
+        */
+        void waitFor(const Uint64 number)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_done.wait(lock, [number] { return done_count >= number; });
+        }
+
+        /**
+        * This function draws a recorded frame and shows it. It's run on the render thread.
+        */
+        void drawFrame(const std::vector<Command>& draw_list)
+        {
+            SDL_Renderer* renderer = Application::getRenderer();
+            Uint64 start = SDL_GetPerformanceCounter();
+            SDL_RenderClear(renderer);
+            Compositor::beginFrame();
+            for (const auto& command : draw_list)
+            {
+                switch (command.type)
+                {
+                case CommandType::Draw:
+                    Compositor::draw(command.texture, command.whole_texture ? nullptr : &command.source_rect, command.destination_rect, command.flip);
+                    break;
+                case CommandType::Rotated:
+                    SpriteCache::draw(command.texture, command.destination_rect, command.angle);
+                    break;
+                case CommandType::BeginWorld:
+                    Compositor::beginWorld(command.scale);
+                    break;
+                case CommandType::EndWorld:
+                    Compositor::endWorld();
+                    break;
+                }
+            }
+            Compositor::endFrame();
+            DynamicResolution::addFrameTime(static_cast<float>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency());
+            SDL_RenderPresent(renderer);
+        }
+    }
+
+    /**
+    * This function starts the render thread. It must be called before the
+    * renderer is created.
+    */
+    void start()
+    {
+        if (running)
+        {
+            return;
+        }
+
+        stopping = false;
+        thread = std::thread(run);
+        thread_id = thread.get_id();
+        running = true;
+        LOG_INFO("Render thread started");
+    }
+
+    /**
+    * This function waits for everything handed to the render thread to finish,
+    * and then stops it.
+    */
+    void stop()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        job_added.notify_one();
+        thread.join();
+        running = false;
+    }
+
+    /**
+    * This function returns whether the render thread is running.
+    */
+    bool isRunning()
+    {
+        return running;
+    }
+
+    /**
+    * This function returns whether draws should be recorded, which is when the render
+    * thread is running and it isn't the thread asking.
+    */
+    bool isRecording()
+    {
+        return running && std::this_thread::get_id() != thread_id;
+    }
+
+    /**
+    * This function runs a function on the render thread, and waits for it to finish.
+    * Anything the function throws is thrown again on the calling thread.
+    */
+    void call(const std::function<void()>& function)
+    {
+        if (!isRecording())
+        {
+            function();
+            return;
+        }
+
+        // Anything thrown on the render thread is thrown again here.
+        std::exception_ptr error;
+        waitFor(addJob([&] {
+            try
+            {
+                function();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }));
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+    * This function records a draw of a texture, like "SDL_RenderCopyEx". Draws with
+    * "rotated" set go through the sprite cache.
+    */
+    void record(SDL_Texture* texture, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const double angle, const SDL_RendererFlip flip, const bool rotated)
+    {
+        Command command = {};
+        command.type = rotated ? CommandType::Rotated : CommandType::Draw;
+        command.texture = texture;
+        command.source_rect = source_rect != nullptr ? *source_rect : SDL_Rect{ 0, 0, 0, 0 };
+        command.destination_rect = destination_rect;
+        command.angle = angle;
+        command.flip = flip;
+        command.whole_texture = source_rect == nullptr;
+        draw_lists[recording_list].push_back(command);
+    }
+
+    /**
+    * This function records the start of the world, like "Compositor::beginWorld".
+    */
+    void recordBeginWorld(const float scale)
+    {
+        Command command = {};
+        command.type = CommandType::BeginWorld;
+        command.scale = scale;
+        draw_lists[recording_list].push_back(command);
+    }
+
+    /**
+    * This function records the end of the world, like "Compositor::endWorld".
+    */
+    void recordEndWorld()
+    {
+        Command command = {};
+        command.type = CommandType::EndWorld;
+        draw_lists[recording_list].push_back(command);
+    }
+
+    /**
+    * This function hands the recorded frame to the render thread to be drawn and shown.
+    */
+    void submitFrame()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        // The other list was drawn two frames ago, but the frame before this one
+        // has to be shown before this one can be handed over anyway.
+        waitFor(last_frame);
+
+        int list = recording_list;
+        draw_count = draw_lists[list].size();
+        recording_list = 1 - recording_list;
+        draw_lists[recording_list].clear();
+        Uint32 input_time = Input::getInputTime();
+        last_frame = addJob([list, input_time] {
+            drawFrame(draw_lists[list]);
+            Input::addPresentTime(input_time);
+        });
+    }
+
+    /**
+    * This function returns how many draws were recorded in the last frame.
+    */
+    std::size_t getDrawCount()
+    {
+        return draw_count;
+    }
+}
\ No newline at end of file
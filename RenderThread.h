@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Application.h"
+#include <functional>
+
+/**
+* This namespace runs all of the renderer's work on its own thread, so a frame can be
+* drawn while the next one is being updated. While a state draws, its draws are recorded
+* into a draw list instead of being done straight away. When the frame is finished, the
+* list is handed to the render thread, and the next frame is recorded into the other list.
+* The game thread only waits if the render thread is still drawing the frame before, so
+* frames are shown at most one frame late.
+*
+* Anything else that uses the renderer, like loading a texture, is run on the render
+* thread with "call", in order with the frames that were handed over before it. A texture
+* that has been drawn must not be destroyed until the frame it was drawn in has finished.
+*
+* When the render thread isn't running, everything is done straight away on the calling
+* thread, as before.
+*/
+namespace RenderThread
+{
+    /**
+    * This function starts the render thread. It must be called before the
+    * renderer is created.
+    */
+    void start();
+
+    /**
+    * This function waits for everything handed to the render thread to finish,
+    * and then stops it.
+    */
+    void stop();
+
+    /**
+    * This function returns whether the render thread is running.
+    */
+    bool isRunning();
+
+    /**
+    * This function returns whether draws should be recorded, which is when the render
+    * thread is running and it isn't the thread asking.
+    */
+    bool isRecording();
+
+    /**
+    * This function runs a function on the render thread, and waits for it to finish.
+    * Anything the function throws is thrown again on the calling thread.
+    */
+    void call(const std::function<void()>& function);
+
+    /**
+    * This function records a draw of a texture, like "SDL_RenderCopyEx". Draws with
+    * "rotated" set go through the sprite cache.
+    */
+    void record(SDL_Texture* texture, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const double angle, const SDL_RendererFlip flip, const bool rotated);
+
+    /**
+    * This function records the start of the world, like "Compositor::beginWorld".
+    */
+    void recordBeginWorld(const float scale);
+
+    /**
+    * This function records the end of the world, like "Compositor::endWorld".
+    */
+    void recordEndWorld();
+
+    /**
+    * This function hands the recorded frame to the render thread to be drawn and shown.
+    */
+    void submitFrame();
+
+    /**
+    * This function returns how many draws were recorded in the last frame.
+    */
+    std::size_t getDrawCount();
+}
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include "Replay.h"
+#include "Application.h"
+#include "Tools.h"
+
+#include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+
+/**
+* This namespace handles recording and replaying play sessions. A replay file holds
+* the random seed, and then the delta time, the input events and a hash of the game
+* state for every frame. Replaying a file feeds the recorded delta times and events
+* back into the game loop, and compares the state hashes to detect desyncs.
+*/
+namespace Replay
+{
+    /**
+    * This anonymous namespace holds the replay file and the playback statistics.
+    */
+    namespace
+    {
+        const char MAGIC[4] = { 'T', 'D', 'R', 'P' };
+        // Version 2 reads input as a snapshot each frame, so older replays play differently.
+        const Uint8 VERSION = 2;
+
+        // These identify each type of input event in the replay file.
+        enum EventCode : Uint8
+        {
+            KEY_DOWN,
+            KEY_UP,
+            MOUSE_MOTION,
+            MOUSE_BUTTON_DOWN,
+            MOUSE_BUTTON_UP,
+            MOUSE_WHEEL
+        };
+
+        Mode mode = Mode::Off;
+        std::fstream file;
+        std::string file_name;
+        Uint32 frame = 0;
+        Uint32 desyncs = 0;
+
+        /**
+        * These functions write and read values in little endian order, so replay
+        * files can be shared between machines.
+        */
+        void write8(const Uint8 value)
+        {
+            file.put(static_cast<char>(value));
+        }
+
+        void write16(const Uint16 value)
+        {
+            write8(static_cast<Uint8>(value));
+            write8(static_cast<Uint8>(value >> 8));
+        }
+
+        void write32(const Uint32 value)
+        {
+            write16(static_cast<Uint16>(value));
+            write16(static_cast<Uint16>(value >> 16));
+        }
+
+        Uint8 read8()
+        {
+            return static_cast<Uint8>(file.get());
+        }
+
+        Uint16 read16()
+        {
+            Uint16 low = read8();
+            return static_cast<Uint16>(low | (read8() << 8));
+        }
+
+        Uint32 read32()
+        {
+            Uint32 low = read16();
+            return low | (static_cast<Uint32>(read16()) << 16);
+        }
+
+        /**
+        * This function folds a 64 bit hash into 32 bits, which is plenty for spotting
+        * a desync and keeps the replay file small.
+        */
+        Uint32 foldHash(const Uint64 hash)
+        {
+            return static_cast<Uint32>(hash ^ (hash >> 32));
+        }
+
+        /**
+        * This function writes a single input event. Only the fields the game reads
+        * are written.
+        */
+        void writeEvent(const SDL_Event& event)
+        {
+            switch (event.type)
+            {
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                write8(event.type == SDL_KEYDOWN ? KEY_DOWN : KEY_UP);
+                write32(static_cast<Uint32>(event.key.keysym.sym));
+                write8(event.key.repeat);
+                break;
+            case SDL_MOUSEMOTION:
+                write8(MOUSE_MOTION);
+                write16(static_cast<Uint16>(event.motion.x));
+                write16(static_cast<Uint16>(event.motion.y));
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                write8(event.type == SDL_MOUSEBUTTONDOWN ? MOUSE_BUTTON_DOWN : MOUSE_BUTTON_UP);
+                write8(event.button.button);
+                write16(static_cast<Uint16>(event.button.x));
+                write16(static_cast<Uint16>(event.button.y));
+                break;
+            case SDL_MOUSEWHEEL:
+                write8(MOUSE_WHEEL);
+                write16(static_cast<Uint16>(event.wheel.x));
+                write16(static_cast<Uint16>(event.wheel.y));
+                break;
+            default:
+                break;
+            }
+        }
+
+        /**
+        * This function reads a single input event written by "writeEvent".
+        */
+        SDL_Event readEvent()
+        {
+            SDL_Event event;
+            std::memset(&event, 0, sizeof(event));
+
+            Uint8 code = read8();
+            switch (code)
+            {
+            case KEY_DOWN:
+            case KEY_UP:
+                event.type = code == KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+                event.key.keysym.sym = static_cast<SDL_Keycode>(read32());
+                event.key.repeat = read8();
+                break;
+            case MOUSE_MOTION:
+                event.type = SDL_MOUSEMOTION;
+                event.motion.x = static_cast<Sint16>(read16());
+                event.motion.y = static_cast<Sint16>(read16());
+                break;
+            case MOUSE_BUTTON_DOWN:
+            case MOUSE_BUTTON_UP:
+                event.type = code == MOUSE_BUTTON_DOWN ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+                event.button.button = read8();
+                event.button.x = static_cast<Sint16>(read16());
+                event.button.y = static_cast<Sint16>(read16());
+                break;
+            case MOUSE_WHEEL:
+                event.type = SDL_MOUSEWHEEL;
+                event.wheel.x = static_cast<Sint16>(read16());
+                event.wheel.y = static_cast<Sint16>(read16());
+                break;
+            default:
+                break;
+            }
+
+            return event;
+        }
+    }
+
+    /**
+    * This method adds raw bytes to the hash.
+    */
+    void StateHash::add(const void* data, const std::size_t size)
+    {
+        const Uint8* bytes = static_cast<const Uint8*>(data);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    /**
+    * This method adds an int to the hash.
+    */
+    void StateHash::add(const int value)
+    {
+        add(&value, sizeof(value));
+    }
+
+    /**
+    * This method adds a rect to the hash.
+    */
+    void StateHash::add(const SDL_Rect& rect)
+    {
+        add(rect.x);
+        add(rect.y);
+        add(rect.w);
+        add(rect.h);
+    }
+
+    /**
+    * This method returns the hash.
+    */
+    Uint64 StateHash::get() const
+    {
+        return hash;
+    }
+
+    /**
+    * This function starts recording to a replay file. The random number generator
+    * is seeded here, so this must be called before the first state starts up.
+    */
+    void startRecording(const std::string& file_name)
+    {
+        Replay::file_name = file_name;
+        file.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            SDL_SetError(("Couldn't create replay file: " + file_name).c_str());
+            throw Application::Error::File;
+        }
+
+        unsigned int seed = static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
+        Tools::seedRandom(seed);
+
+        file.write(MAGIC, sizeof(MAGIC));
+        write8(VERSION);
+        write32(seed);
+
+        mode = Mode::Recording;
+        frame = 0;
+        LOG_INFO("Recording replay: " << file_name << " (seed " << seed << ")");
+    }
+
+    /**
+    * This function starts playing back a replay file. The random number generator
+    * is seeded with the recorded seed, so this must be called before the first
+    * state starts up.
+    */
+    void startPlayback(const std::string& file_name)
+    {
+        Replay::file_name = file_name;
+        file.open(file_name, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            SDL_SetError(("Couldn't open replay file: " + file_name).c_str());
+            throw Application::Error::File;
+        }
+
+        char magic[sizeof(MAGIC)];
+        file.read(magic, sizeof(magic));
+        if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || read8() != VERSION)
+        {
+            SDL_SetError(("Not a valid replay file: " + file_name).c_str());
+            throw Application::Error::File;
+        }
+
+        unsigned int seed = read32();
+        Tools::seedRandom(seed);
+
+        mode = Mode::Playing;
+        frame = 0;
+        desyncs = 0;
+        LOG_INFO("Playing replay: " << file_name << " (seed " << seed << ")");
+    }
+
+    /**
+    * This function stops recording or playback and closes the replay file.
+    */
+    void stop()
+    {
+        if (mode == Mode::Recording)
+        {
+            LOG_INFO("Recorded " << frame << " frames to replay: " << file_name);
+        }
+        else if (mode == Mode::Playing)
+        {
+            LOG_INFO("Played " << frame << " frames from replay: " << file_name << " (" << desyncs << " desyncs)");
+        }
+
+        if (file.is_open())
+        {
+            file.close();
+        }
+        mode = Mode::Off;
+    }
+
+    /**
+    * This function returns whether a session is being recorded, played back or neither.
+    */
+    Mode getMode()
+    {
+        return mode;
+    }
+
+    /**
+    * This function returns whether the event is an input event that is recorded and
+    * replayed. Live input events are ignored while a replay is playing.
+    */
+    bool isInputEvent(const SDL_Event& event)
+    {
+        switch (event.type)
+        {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+    * This function writes the delta time and input events of a frame to the replay file.
+    */
+    void recordFrame(const float delta_time, const std::vector<SDL_Event>& events)
+    {
+        // The delta time is stored bit for bit, so that playback is exact.
+        Uint32 delta_bits;
+        std::memcpy(&delta_bits, &delta_time, sizeof(delta_bits));
+        write32(delta_bits);
+
+        // Only input events are written, so only they are counted. Otherwise playback
+        // would read an event for every window event and lose its place in the file.
+        write16(static_cast<Uint16>(std::count_if(events.begin(), events.end(), isInputEvent)));
+        for (const auto& event : events)
+        {
+            writeEvent(event);
+        }
+    }
+
+    /**
+    * This function reads the delta time and input events of the next frame from the replay
+    * file. It returns false when there are no frames left.
+    */
+    bool playFrame(float& delta_time, std::vector<SDL_Event>& events)
+    {
+        Uint32 delta_bits = read32();
+        if (!file)
+        {
+            return false;
+        }
+        std::memcpy(&delta_time, &delta_bits, sizeof(delta_time));
+
+        events.clear();
+        Uint16 event_count = read16();
+        for (Uint16 i = 0; i < event_count; i++)
+        {
+            events.push_back(readEvent());
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    /**
+    * This function is called once the frame has been updated. When recording, the state
+    * hash is written to the file. When playing, it is compared with the recorded hash.
+    */
+    void endFrame(const Uint64 state_hash)
+    {
+        if (mode == Mode::Recording)
+        {
+            write32(foldHash(state_hash));
+        }
+        else if (mode == Mode::Playing)
+        {
+            if (read32() != foldHash(state_hash))
+            {
+                if (desyncs++ == 0)
+                {
+                    LOG_WARNING("Replay desync at frame " << frame);
+                }
+            }
+        }
+        frame++;
+    }
+}
\ No newline at end of file
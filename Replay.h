@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+/**
+* This namespace handles recording and replaying play sessions. A replay file holds
+* the random seed, and then the delta time, the input events and a hash of the game
+* state for every frame. Replaying a file feeds the recorded delta times and events
+* back into the game loop, and compares the state hashes to detect desyncs.
+*/
+namespace Replay
+{
+    enum class Mode
+    {
+        Off,
+        Recording,
+        Playing
+    };
+
+    /**
+    * This class builds a hash of the game state. Each state adds whatever
+    * values determine the outcome of the game to it.
+    */
+    class StateHash
+    {
+    public:
+        /**
+        * This method adds raw bytes to the hash.
+        */
+        void add(const void* data, const std::size_t size);
+
+        /**
+        * This method adds an int to the hash.
+        */
+        void add(const int value);
+
+        /**
+        * This method adds a rect to the hash.
+        */
+        void add(const SDL_Rect& rect);
+
+        /**
+        * This method returns the hash.
+        */
+        Uint64 get() const;
+
+    private:
+        // FNV-1a offset basis.
+        Uint64 hash = 14695981039346656037ULL;
+    };
+
+    /**
+    * This function starts recording to a replay file. The random number generator
+    * is seeded here, so this must be called before the first state starts up.
+    */
+    void startRecording(const std::string& file_name);
+
+    /**
+    * This function starts playing back a replay file. The random number generator
+    * is seeded with the recorded seed, so this must be called before the first
+    * state starts up.
+    */
+    void startPlayback(const std::string& file_name);
+
+    /**
+    * This function stops recording or playback and closes the replay file.
+    */
+    void stop();
+
+    /**
+    * This function returns whether a session is being recorded, played back or neither.
+    */
+    Mode getMode();
+
+    /**
+    * This function returns whether the event is an input event that is recorded and
+    * replayed. Live input events are ignored while a replay is playing.
+    */
+    bool isInputEvent(const SDL_Event& event);
+
+    /**
+    * This function writes the delta time and input events of a frame to the replay file.
+    */
+    void recordFrame(const float delta_time, const std::vector<SDL_Event>& events);
+
+    /**
+    * This function reads the delta time and input events of the next frame from the replay
+    * file. It returns false when there are no frames left.
+    */
+    bool playFrame(float& delta_time, std::vector<SDL_Event>& events);
+
+    /**
+    * This function is called once the frame has been updated. When recording, the state
+    * hash is written to the file. When playing, it is compared with the recorded hash.
+    */
+    void endFrame(const Uint64 state_hash);
+}
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "SelectionList.h"
+#include "Compositor.h"
+
+#include <algorithm>
 
 SelectionList::SelectionList(const std::vector<std::string>& options_list, const int x, const int y)
     : options(options_list),
@@ -21,11 +24,11 @@ SelectionList::SelectionList(const std::vector<std::string>& options_list, const
 void SelectionList::draw()
 {
     option.draw();
-    SDL_RenderCopy(Application::getRenderer(), arrow, nullptr, &right);
-    SDL_RenderCopyEx(Application::getRenderer(), arrow, nullptr, &left, 0, nullptr, SDL_FLIP_HORIZONTAL);
+    Compositor::draw(arrow, nullptr, right);
+    Compositor::draw(arrow, nullptr, left, SDL_FLIP_HORIZONTAL);
 }
 
-void SelectionList::pressed()
+bool SelectionList::pressed()
 {
     if (right_hovering)
     {
@@ -35,6 +38,7 @@ void SelectionList::pressed()
             index = 0;
         }
         setSelection();
+        return true;
     }
     else if (left_hovering)
     {
@@ -44,7 +48,9 @@ void SelectionList::pressed()
             index = options.size() - 1;
         }
         setSelection();
+        return true;
     }
+    return false;
 }
 
 void SelectionList::update()
@@ -82,6 +88,11 @@ const std::string& SelectionList::getCurrentOption()
     return options[index];
 }
 
+SDL_Rect SelectionList::getRect()
+{
+    return { left.x, left.y, (right.x + right.w) - left.x, std::max(option.getRect().h, right.h) };
+}
+
 void SelectionList::setSelection()
 {
     option.setText(options[index]);
@@ -89,4 +100,4 @@ void SelectionList::setSelection()
     right.y = option.getRect().y;
     left.x = option.getRect().x - left.w - 10;
     left.y = option.getRect().y;
-}
+}
\ No newline at end of file
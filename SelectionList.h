@@ -8,10 +8,11 @@ class SelectionList
 public:
     SelectionList(const std::vector<std::string>& options_list, const int x, const int y);
     void draw();
-    void pressed();
+    bool pressed();
     void update();
     void setCurrentOption(const std::string& string);
     const std::string& getCurrentOption();
+    SDL_Rect getRect();
 
 private:
     void setSelection();
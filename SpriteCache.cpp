@@ -0,0 +1,226 @@
+#include "SpriteCache.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+#include "TextureCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+/**
+* This namespace holds copies of sprites that have already been rotated. SDL's software
+* renderer rotates and blends a sprite pixel by pixel every time it's drawn at an angle,
+* which is one of the slowest things it does. Instead, each sprite is rotated to a number
+* of evenly spaced angles when it's loaded, and drawing it at an angle just copies the
+* closest one.
+*
+* By default this is only used with the software renderer or the compositor, where it's
+* worth losing a little accuracy in the angle. Sprites that would go over the memory budget are drawn
+* normally.
+*/
+namespace SpriteCache
+{
+    /**
+    * This anonymous namespace holds the rotated copies of every prepared sprite.
+    */
+    namespace
+    {
+        /**
+        * This struct holds every rotation of one sprite. Each rotation is a square big
+        * enough to hold the sprite at any angle, with the sprite in the middle.
+        */
+        struct Sprite
+        {
+            int width;
+            int height;
+            int side;
+            std::vector<SDL_Texture*> rotations;
+        };
+
+        bool enabled = false;
+        int rotation_count = DEFAULT_ROTATIONS;
+        std::unordered_map<SDL_Texture*, Sprite> sprites;
+        std::size_t memory = 0;
+
+        /**
+        * This function rotates a texture to every angle. It returns false if the
+        * renderer can't draw to a texture.
+        */
+        bool rotate(SDL_Texture* texture, Sprite& sprite)
+        {
+            SDL_Renderer* renderer = Application::getRenderer();
+            SDL_Texture* target = SDL_GetRenderTarget(renderer);
+            Uint8 red, green, blue, alpha;
+            SDL_GetRenderDrawColor(renderer, &red, &green, &blue, &alpha);
+
+            // The sprite is copied without blending, so its edges keep their alpha
+            // instead of being blended with the empty rotation.
+            SDL_BlendMode blend_mode;
+            SDL_GetTextureBlendMode(texture, &blend_mode);
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+
+            SDL_Rect rect = { (sprite.side - sprite.width) / 2, (sprite.side - sprite.height) / 2, sprite.width, sprite.height };
+            bool success = true;
+            for (int i = 0; i < rotation_count; i++)
+            {
+                SDL_Texture* rotation = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, sprite.side, sprite.side);
+                if (rotation == nullptr || SDL_SetRenderTarget(renderer, rotation) != 0)
+                {
+                    SDL_DestroyTexture(rotation);
+                    success = false;
+                    break;
+                }
+                SDL_SetTextureBlendMode(rotation, SDL_BLENDMODE_BLEND);
+                SDL_RenderClear(renderer);
+                SDL_RenderCopyEx(renderer, texture, nullptr, &rect, (360.0 * i) / rotation_count, nullptr, SDL_FLIP_NONE);
+                Compositor::capture(rotation);
+                sprite.rotations.push_back(rotation);
+            }
+
+            SDL_SetRenderTarget(renderer, target);
+            SDL_SetRenderDrawColor(renderer, red, green, blue, alpha);
+            SDL_SetTextureBlendMode(texture, blend_mode);
+
+            if (!success)
+            {
+                for (auto rotation : sprite.rotations)
+                {
+                    Compositor::removeImage(rotation);
+                    SDL_DestroyTexture(rotation);
+                }
+                sprite.rotations.clear();
+            }
+            return success;
+        }
+    }
+
+    /**
+    * This function sets when rotated sprites are used, and how many angles each sprite
+    * is rotated to. More angles look smoother but use more memory. It must be called
+    * after the renderer has been created.
+    */
+    void setup(const Mode mode, const int rotations)
+    {
+        RenderThread::call([&] {
+            clear();
+            rotation_count = std::max(1, std::min(rotations, MAXIMUM_ROTATIONS));
+
+            SDL_RendererInfo info;
+            bool software = SDL_GetRendererInfo(Application::getRenderer(), &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE);
+            enabled = mode == Mode::On || (mode == Mode::Auto && (software || Compositor::isEnabled()));
+            LOG_INFO("Rotated sprites " << (enabled ? "on, " + std::to_string(rotation_count) + " angles" : "off") << " (renderer: " << info.name << ")");
+        });
+    }
+
+    /**
+    * This function loads a texture, and rotates it to every angle if rotated sprites
+    * are being used.
+    */
+    void prepare(const std::string& file_name)
+    {
+        RenderThread::call([&] {
+            SDL_Texture* texture = Application::getTexture(file_name);
+            if (!enabled || sprites.find(texture) != sprites.end())
+            {
+                return;
+            }
+
+            Sprite sprite;
+            SDL_QueryTexture(texture, nullptr, nullptr, &sprite.width, &sprite.height);
+            sprite.side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>((sprite.width * sprite.width) + (sprite.height * sprite.height)))));
+
+            std::size_t sprite_memory = static_cast<std::size_t>(sprite.side) * sprite.side * 4 * rotation_count;
+            if (memory + sprite_memory > MEMORY_BUDGET)
+            {
+                LOG_WARNING("Not enough memory to rotate " << file_name << ", it will be rotated when drawn");
+                return;
+            }
+            if (!rotate(texture, sprite))
+            {
+                LOG_WARNING("Couldn't rotate " << file_name << ": " << SDL_GetError());
+                return;
+            }
+
+            for (auto rotation : sprite.rotations)
+            {
+                TextureCache::add(rotation);
+            }
+            LOG_DEBUG("Rotated " << file_name << " to " << rotation_count << " angles");
+            memory += sprite_memory;
+            sprites[texture] = std::move(sprite);
+        });
+    }
+
+    /**
+    * This function draws a texture rotated by "angle" degrees around its centre.
+    */
+    void draw(SDL_Texture* texture, const SDL_Rect& draw_rect, const double angle)
+    {
+        if (RenderThread::isRecording())
+        {
+            RenderThread::record(texture, nullptr, draw_rect, angle, SDL_FLIP_NONE, true);
+            return;
+        }
+
+        auto sprite_it = sprites.find(texture);
+        if (sprite_it == sprites.end())
+        {
+            Compositor::flush();
+            SDL_RenderCopyEx(Application::getRenderer(), texture, nullptr, &draw_rect, angle, nullptr, SDL_FLIP_NONE);
+            return;
+        }
+
+        // The rotation is scaled the same way the sprite would have been, and is
+        // centred on the same point.
+        const Sprite& sprite = sprite_it->second;
+        int rotation = static_cast<int>(std::lround((angle * rotation_count) / 360.0)) % rotation_count;
+        if (rotation < 0)
+        {
+            rotation += rotation_count;
+        }
+
+        SDL_Rect rect;
+        rect.w = (sprite.side * draw_rect.w) / sprite.width;
+        rect.h = (sprite.side * draw_rect.h) / sprite.height;
+        rect.x = draw_rect.x + (draw_rect.w / 2) - (rect.w / 2);
+        rect.y = draw_rect.y + (draw_rect.h / 2) - (rect.h / 2);
+        Compositor::draw(sprite.rotations[rotation], nullptr, rect);
+    }
+
+    /**
+    * This function destroys every rotated sprite.
+    */
+    void clear()
+    {
+        RenderThread::call([&] {
+            for (auto& sprite : sprites)
+            {
+                for (auto rotation : sprite.second.rotations)
+                {
+                    TextureCache::remove(rotation);
+                    Compositor::removeImage(rotation);
+                    SDL_DestroyTexture(rotation);
+                }
+            }
+            sprites.clear();
+            memory = 0;
+        });
+    }
+
+    /**
+    * This function returns whether rotated sprites are being used.
+    */
+    bool isEnabled()
+    {
+        return enabled;
+    }
+
+    /**
+    * This function returns roughly how many bytes the rotated sprites take up.
+    */
+    std::size_t getMemory()
+    {
+        return memory;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This namespace holds copies of sprites that have already been rotated. SDL's software
+* renderer rotates and blends a sprite pixel by pixel every time it's drawn at an angle,
+* which is one of the slowest things it does. Instead, each sprite is rotated to a number
+* of evenly spaced angles when it's loaded, and drawing it at an angle just copies the
+* closest one.
+*
+* By default this is only used with the software renderer or the compositor, where it's
+* worth losing a little accuracy in the angle. Sprites that would go over the memory budget are drawn
+* normally.
+*/
+namespace SpriteCache
+{
+    enum class Mode
+    {
+        Auto,
+        On,
+        Off
+    };
+
+    /**
+    * This function sets when rotated sprites are used, and how many angles each sprite
+    * is rotated to. More angles look smoother but use more memory. It must be called
+    * after the renderer has been created.
+    */
+    void setup(const Mode mode, const int rotations);
+
+    /**
+    * This function loads a texture, and rotates it to every angle if rotated sprites
+    * are being used.
+    */
+    void prepare(const std::string& file_name);
+
+    /**
+    * This function draws a texture rotated by "angle" degrees around its centre.
+    */
+    void draw(SDL_Texture* texture, const SDL_Rect& draw_rect, const double angle);
+
+    /**
+    * This function destroys every rotated sprite.
+    */
+    void clear();
+
+    /**
+    * This function returns whether rotated sprites are being used.
+    */
+    bool isEnabled();
+
+    /**
+    * This function returns roughly how many bytes the rotated sprites take up.
+    */
+    std::size_t getMemory();
+
+    const int DEFAULT_ROTATIONS = 64;
+    const int MAXIMUM_ROTATIONS = 360;
+    const std::size_t MEMORY_BUDGET = 16 * 1024 * 1024;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+// This program doesn't open a window, so SDL doesn't need to replace "main".
+#define SDL_MAIN_HANDLED
+#include "../Replay.h"
+
+#include <cstdio>
+#include <iostream>
+
+/**
+* This program records a couple of frames to a replay file, plays them back, and checks
+* that the same delta times and input events come back out. The first frame has window
+* and quit events mixed in with the input, like the first frames of a real session,
+* which aren't recorded. Build it together with Replay.cpp, Tools.cpp, Random.cpp and
+* Log.cpp. It returns 0 if the replay plays back correctly.
+*/
+namespace
+{
+    const char* FILE_NAME = "ReplayRoundTrip.replay";
+
+    int failures = 0;
+
+    /**
+    * This function prints a message and counts a failure if "passed" is false.
+    */
+    void check(const bool passed, const std::string& message)
+    {
+        if (!passed)
+        {
+            std::cout << "FAILED: " << message << std::endl;
+            failures++;
+        }
+    }
+
+    /**
+    * These functions make the events that are recorded.
+    */
+    SDL_Event makeEvent(const Uint32 type)
+    {
+        SDL_Event event = {};
+        event.type = type;
+        return event;
+    }
+
+    SDL_Event makeKey(const Uint32 type, const SDL_Keycode key)
+    {
+        SDL_Event event = makeEvent(type);
+        event.key.keysym.sym = key;
+        return event;
+    }
+
+    SDL_Event makeMotion(const int x, const int y)
+    {
+        SDL_Event event = makeEvent(SDL_MOUSEMOTION);
+        event.motion.x = x;
+        event.motion.y = y;
+        return event;
+    }
+}
+
+int main()
+{
+    Replay::startRecording(FILE_NAME);
+    Replay::recordFrame(0.016f, {
+        makeEvent(SDL_WINDOWEVENT),
+        makeKey(SDL_KEYDOWN, SDLK_w),
+        makeEvent(SDL_QUIT),
+        makeMotion(320, 240)
+    });
+    Replay::endFrame(1);
+    Replay::recordFrame(0.02f, { makeKey(SDL_KEYUP, SDLK_w) });
+    Replay::endFrame(2);
+    Replay::stop();
+
+    float delta_time = 0.0;
+    std::vector<SDL_Event> events;
+    Replay::startPlayback(FILE_NAME);
+
+    check(Replay::playFrame(delta_time, events), "the first frame couldn't be read");
+    check(delta_time == 0.016f, "the first frame's delta time is wrong");
+    check(events.size() == 2, "the first frame should only have its two input events");
+    if (events.size() == 2)
+    {
+        check(events[0].type == SDL_KEYDOWN && events[0].key.keysym.sym == SDLK_w, "the key press is wrong");
+        check(events[1].type == SDL_MOUSEMOTION && events[1].motion.x == 320 && events[1].motion.y == 240, "the mouse motion is wrong");
+    }
+    Replay::endFrame(1);
+
+    check(Replay::playFrame(delta_time, events), "the second frame couldn't be read");
+    check(delta_time == 0.02f, "the second frame's delta time is wrong");
+    check(events.size() == 1 && events[0].type == SDL_KEYUP && events[0].key.keysym.sym == SDLK_w, "the key release is wrong");
+    Replay::endFrame(2);
+
+    check(!Replay::playFrame(delta_time, events), "there should be no frames left");
+    Replay::stop();
+    std::remove(FILE_NAME);
+
+    std::cout << (failures == 0 ? "Replay round trip passed" : "Replay round trip failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
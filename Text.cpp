@@ -1,4 +1,7 @@
 #include "Text.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+#include "TextureCache.h"
 
 Text::Text(TTF_Font* font, const std::string& text, const int x, const int y, const bool centered, const SDL_Colour& colour, const int width)
 {
@@ -15,7 +18,11 @@ Text::Text(TTF_Font* font, const std::string& text, const int x, const int y, co
 }
 Text::~Text()
 {
-    SDL_DestroyTexture(texture);
+    RenderThread::call([this] {
+        TextureCache::remove(texture);
+        Compositor::removeImage(texture);
+        SDL_DestroyTexture(texture);
+    });
 }
 
 /**
@@ -23,7 +30,7 @@ Text::~Text()
 */
 void Text::draw()
 {
-    SDL_RenderCopy(Application::getRenderer(), texture, nullptr, &rect);
+    Compositor::draw(texture, nullptr, rect);
 }
 
 /**
@@ -41,13 +48,19 @@ void Text::setText(const std::string& text)
         text_surface = TTF_RenderText_Blended(font, text.c_str(), colour);
     }
 
-    if (texture != nullptr)
-    {
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
-    }
+    RenderThread::call([&] {
+        if (texture != nullptr)
+        {
+            TextureCache::remove(texture);
+            Compositor::removeImage(texture);
+            SDL_DestroyTexture(texture);
+            texture = nullptr;
+        }
 
-    texture = SDL_CreateTextureFromSurface(Application::getRenderer(), text_surface);
+        texture = SDL_CreateTextureFromSurface(Application::getRenderer(), text_surface);
+        Compositor::addImage(texture, text_surface);
+        TextureCache::add(texture);
+    });
     SDL_QueryTexture(texture, nullptr, nullptr, &rect.w, &rect.h);
     SDL_FreeSurface(text_surface);
 
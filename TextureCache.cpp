@@ -0,0 +1,304 @@
+#include "TextureCache.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+
+#include <unordered_map>
+
+/**
+* This namespace keeps track of every texture the game has in memory, and how many bytes
+* each one takes up, including the compositor's copy of its pixels.
+*
+* Textures loaded from files are cached by file name. A texture is pinned when something
+* keeps hold of it, so it's never freed until the game quits. Textures that aren't pinned,
+* like the level's tiles, are only used for a moment, so when the cache goes over its
+* budget the ones used least recently are freed, and they're loaded again the next time
+* they're asked for.
+*
+* Textures made some other way, like the level texture, text and rotated sprites, are
+* owned by whatever made them. They're added so they count towards the budget, but
+* they're never freed by the cache.
+*/
+namespace TextureCache
+{
+    /**
+    * This anonymous namespace holds every texture loaded from a file, the size of every
+    * texture that was added, and the counters.
+    */
+    namespace
+    {
+        /**
+        * This struct holds a texture loaded from a file. The texture is null while it
+        * has been freed. "last_used" is when it was last asked for.
+        */
+        struct Entry
+        {
+            SDL_Texture* texture = nullptr;
+            std::size_t bytes = 0;
+            Uint64 last_used = 0;
+            bool pinned = false;
+        };
+
+        std::size_t budget = DEFAULT_BUDGET;
+        std::map<std::string, Entry> entries;
+        std::unordered_map<SDL_Texture*, std::size_t> added;
+        Uint64 use_count = 0;
+        int hold_count = 0;
+
+        std::size_t resident_bytes = 0;
+        std::size_t resident_count = 0;
+        std::size_t evicted_count = 0;
+        std::size_t reload_count = 0;
+        bool warned = false;
+
+        /**
+        * This function returns roughly how many bytes a texture takes up.
+        */
+        std::size_t getBytes(SDL_Texture* texture)
+        {
+            Uint32 format;
+            int width, height;
+            if (SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0)
+            {
+                return 0;
+            }
+
+            // The compositor keeps its pixels as ARGB8888.
+            std::size_t pixels = static_cast<std::size_t>(width) * height;
+            return (pixels * SDL_BYTESPERPIXEL(format)) + (Compositor::isEnabled() ? pixels * 4 : 0);
+        }
+
+        /**
+        * This function loads a texture from a file.
+        */
+        SDL_Texture* load(const std::string& file_name)
+        {
+            SDL_Surface* surface = IMG_Load(file_name.c_str());
+            if (surface == nullptr)
+            {
+                throw Application::Error::IMG;
+            }
+
+            // The compositor keeps its own copy of the pixels.
+            SDL_Texture* texture;
+            RenderThread::call([&] {
+                texture = SDL_CreateTextureFromSurface(Application::getRenderer(), surface);
+                Compositor::addImage(texture, surface);
+            });
+            SDL_FreeSurface(surface);
+            if (texture == nullptr)
+            {
+                throw Application::Error::SDL;
+            }
+            return texture;
+        }
+
+        /**
+        * This function frees the textures that aren't pinned, least recently used first,
+        * until the cache is back under its budget. "keep" is never freed, because it's
+        * about to be used. Nothing is freed while the cache is held.
+        */
+        void trim(const Entry* keep)
+        {
+            if (hold_count > 0)
+            {
+                return;
+            }
+
+            while (resident_bytes > budget)
+            {
+                Entry* oldest = nullptr;
+                std::string oldest_name;
+                for (auto& entry : entries)
+                {
+                    if (entry.second.texture != nullptr && !entry.second.pinned && &entry.second != keep && (oldest == nullptr || entry.second.last_used < oldest->last_used))
+                    {
+                        oldest = &entry.second;
+                        oldest_name = entry.first;
+                    }
+                }
+
+                if (oldest == nullptr)
+                {
+                    if (!warned)
+                    {
+                        LOG_WARNING("Texture memory is over budget, " << resident_bytes / 1024 << "KB of " << budget / 1024 << "KB, and nothing can be freed");
+                        warned = true;
+                    }
+                    return;
+                }
+
+                LOG_DEBUG("Freeing texture: " << oldest_name);
+                RenderThread::call([&] {
+                    Compositor::removeImage(oldest->texture);
+                    SDL_DestroyTexture(oldest->texture);
+                });
+                oldest->texture = nullptr;
+                resident_bytes -= oldest->bytes;
+                resident_count--;
+                evicted_count++;
+            }
+            warned = false;
+        }
+    }
+
+    /**
+    * This function sets how many bytes of textures can be kept before textures that
+    * aren't pinned are freed.
+    */
+    void setup(const std::size_t budget)
+    {
+        TextureCache::budget = budget;
+        LOG_INFO("Texture budget " << budget / (1024 * 1024) << "MB");
+        trim(nullptr);
+    }
+
+    /**
+    * This function returns the texture loaded from a file. If it isn't loaded, it is
+    * loaded now. A pinned texture is never freed until the game quits.
+    */
+    SDL_Texture* getTexture(const std::string& file_name, const bool pinned)
+    {
+        Entry& entry = entries[file_name];
+        entry.last_used = ++use_count;
+        entry.pinned = entry.pinned || pinned;
+        if (entry.texture != nullptr)
+        {
+            return entry.texture;
+        }
+
+        if (entry.bytes != 0)
+        {
+            LOG_DEBUG("Reloading texture: " << file_name);
+            reload_count++;
+        }
+        else
+        {
+            LOG_DEBUG("Loading texture: " << file_name);
+        }
+
+        entry.texture = load(file_name);
+        entry.bytes = getBytes(entry.texture);
+        resident_bytes += entry.bytes;
+        resident_count++;
+        trim(&entry);
+
+        return entry.texture;
+    }
+
+    /**
+    * This function stops textures being freed until release is called, so textures
+    * that are used over and over in a loop, like the level's tiles, are only loaded
+    * once. Holds can be nested.
+    */
+    void hold()
+    {
+        hold_count++;
+    }
+
+    /**
+    * This function undoes a call to hold. When nothing holds the cache any more, it
+    * frees textures until it's back under its budget.
+    */
+    void release()
+    {
+        hold_count--;
+        trim(nullptr);
+    }
+
+    /**
+    * This function counts a texture that something else made and owns.
+    */
+    void add(SDL_Texture* texture)
+    {
+        if (texture == nullptr || added.find(texture) != added.end())
+        {
+            return;
+        }
+
+        std::size_t bytes = getBytes(texture);
+        added[texture] = bytes;
+        resident_bytes += bytes;
+        resident_count++;
+        trim(nullptr);
+    }
+
+    /**
+    * This function stops counting a texture that was added. It must be called before
+    * the texture is destroyed.
+    */
+    void remove(SDL_Texture* texture)
+    {
+        auto added_it = added.find(texture);
+        if (added_it == added.end())
+        {
+            return;
+        }
+
+        resident_bytes -= added_it->second;
+        resident_count--;
+        added.erase(added_it);
+    }
+
+    /**
+    * This function frees every texture loaded from a file, and forgets every texture
+    * that was added. It must be called on the render thread.
+    */
+    void clear()
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.second.texture != nullptr)
+            {
+                LOG_DEBUG("Unloading texture: " << entry.first);
+                Compositor::removeImage(entry.second.texture);
+                SDL_DestroyTexture(entry.second.texture);
+            }
+        }
+        entries.clear();
+        added.clear();
+        resident_bytes = 0;
+        resident_count = 0;
+    }
+
+    /**
+    * This function returns how many bytes of textures are in memory.
+    */
+    std::size_t getResidentBytes()
+    {
+        return resident_bytes;
+    }
+
+    /**
+    * This function returns how many textures are in memory.
+    */
+    std::size_t getResidentCount()
+    {
+        return resident_count;
+    }
+
+    /**
+    * This function returns how many times a texture has been freed to stay under the budget.
+    */
+    std::size_t getEvictedCount()
+    {
+        return evicted_count;
+    }
+
+    /**
+    * This function returns how many times a texture that was freed has been loaded again.
+    */
+    std::size_t getReloadCount()
+    {
+        return reload_count;
+    }
+
+    /**
+    * This function writes how much texture memory is in use, and how many textures
+    * have been freed and loaded again, to the log.
+    */
+    void logReport()
+    {
+        LOG_INFO("Textures: " << resident_count << " in memory using " << resident_bytes / 1024 << "KB of " << budget / 1024 << "KB, "
+            << evicted_count << " freed, " << reload_count << " loaded again");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This namespace keeps track of every texture the game has in memory, and how many bytes
+* each one takes up, including the compositor's copy of its pixels.
+*
+* Textures loaded from files are cached by file name. A texture is pinned when something
+* keeps hold of it, so it's never freed until the game quits. Textures that aren't pinned,
+* like the level's tiles, are only used for a moment, so when the cache goes over its
+* budget the ones used least recently are freed, and they're loaded again the next time
+* they're asked for.
+*
+* Textures made some other way, like the level texture, text and rotated sprites, are
+* owned by whatever made them. They're added so they count towards the budget, but
+* they're never freed by the cache.
+*/
+namespace TextureCache
+{
+    /**
+    * This function sets how many bytes of textures can be kept before textures that
+    * aren't pinned are freed.
+    */
+    void setup(const std::size_t budget);
+
+    /**
+    * This function returns the texture loaded from a file. If it isn't loaded, it is
+    * loaded now. A pinned texture is never freed until the game quits.
+    */
+    SDL_Texture* getTexture(const std::string& file_name, const bool pinned);
+
+    /**
+    * This function stops textures being freed until release is called, so textures
+    * that are used over and over in a loop, like the level's tiles, are only loaded
+    * once. Holds can be nested.
+    */
+    void hold();
+
+    /**
+    * This function undoes a call to hold. When nothing holds the cache any more, it
+    * frees textures until it's back under its budget.
+    */
+    void release();
+
+    /**
+    * This function counts a texture that something else made and owns.
+    */
+    void add(SDL_Texture* texture);
+
+    /**
+    * This function stops counting a texture that was added. It must be called before
+    * the texture is destroyed.
+    */
+    void remove(SDL_Texture* texture);
+
+    /**
+    * This function frees every texture loaded from a file, and forgets every texture
+    * that was added. It must be called on the render thread.
+    */
+    void clear();
+
+    /**
+    * This function returns how many bytes of textures are in memory.
+    */
+    std::size_t getResidentBytes();
+
+    /**
+    * This function returns how many textures are in memory.
+    */
+    std::size_t getResidentCount();
+
+    /**
+    * This function returns how many times a texture has been freed to stay under the budget.
+    */
+    std::size_t getEvictedCount();
+
+    /**
+    * This function returns how many times a texture that was freed has been loaded again.
+    */
+    std::size_t getReloadCount();
+
+    /**
+    * This function writes how much texture memory is in use, and how many textures
+    * have been freed and loaded again, to the log.
+    */
+    void logReport();
+
+    const std::size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+}
\ No newline at end of file
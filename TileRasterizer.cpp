@@ -0,0 +1,181 @@
+#include "TileRasterizer.h"
+
+#include <algorithm>
+
+TileRasterizer::~TileRasterizer()
+{
+    stop();
+}
+
+/**
+* This method starts the worker threads. A thread count of 0 uses one thread
+* per CPU core.
+*/
+void TileRasterizer::start(const int thread_count)
+{
+    stop();
+
+    int count = thread_count > 0 ? thread_count : SDL_GetCPUCount();
+    stopping = false;
+    for (int i = 1; i < count; i++)
+    {
+        workers.emplace_back(&TileRasterizer::work, this);
+    }
+}
+
+/**
+* This method stops the worker threads.
+*/
+void TileRasterizer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    frame_started.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+}
+
+/**
+* This method records a draw of part of an image. The image must not change until
+* the frame has been drawn.
+*/
+void TileRasterizer::add(const Blitter::Image& image, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const bool flip_horizontal)
+{
+    Command command;
+    command.image = &image;
+    command.source_rect = source_rect != nullptr ? *source_rect : SDL_Rect{ 0, 0, 0, 0 };
+    command.destination_rect = destination_rect;
+    command.whole_image = source_rect == nullptr;
+    command.flip_horizontal = flip_horizontal;
+    commands.push_back(command);
+}
+
+/**
+* This method does every recorded draw onto a frame, and then forgets them.
+*/
+void TileRasterizer::draw(Blitter::Image& frame)
+{
+    if (commands.empty())
+    {
+        return;
+    }
+
+    tile_columns = (frame.width + TILE_SIZE - 1) / TILE_SIZE;
+    tile_rows = (frame.height + TILE_SIZE - 1) / TILE_SIZE;
+    bins.resize(tile_columns * tile_rows);
+    for (auto& bin : bins)
+    {
+        bin.clear();
+    }
+
+    // Put every draw in the bin of each tile it touches.
+    for (Uint32 i = 0; i < commands.size(); i++)
+    {
+        const SDL_Rect& rect = commands[i].destination_rect;
+        int left = std::max(rect.x, 0) / TILE_SIZE;
+        int top = std::max(rect.y, 0) / TILE_SIZE;
+        int right = (std::min(rect.x + rect.w, frame.width) - 1) / TILE_SIZE;
+        int bottom = (std::min(rect.y + rect.h, frame.height) - 1) / TILE_SIZE;
+        if (rect.w <= 0 || rect.h <= 0 || rect.x >= frame.width || rect.y >= frame.height || rect.x + rect.w <= 0 || rect.y + rect.h <= 0)
+        {
+            continue;
+        }
+
+        for (int y = top; y <= bottom; y++)
+        {
+            for (int x = left; x <= right; x++)
+            {
+                bins[(y * tile_columns) + x].push_back(i);
+            }
+        }
+    }
+
+    // Wake the workers and help them.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->frame = &frame;
+        next_tile = 0;
+        busy_workers = static_cast<int>(workers.size());
+        frame_number++;
+    }
+    frame_started.notify_all();
+
+    drawTiles();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    frame_finished.wait(lock, [this] { return busy_workers == 0; });
+    commands.clear();
+}
+
+/**
+* This method returns whether there are any recorded draws.
+*/
+bool TileRasterizer::isEmpty()
+{
+    return commands.empty();
+}
+
+/**
+* This method returns how many threads draw each frame, including the one that
+* calls "draw".
+*/
+int TileRasterizer::getThreadCount()
+{
+    return static_cast<int>(workers.size()) + 1;
+}
+
+/**
+* This method is run by each worker thread. It waits for a frame, and then
+* draws tiles until there are none left.
+*/
+void TileRasterizer::work()
+{
+    Uint64 last_frame = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            frame_started.wait(lock, [&] { return stopping || frame_number != last_frame; });
+            if (stopping)
+            {
+                return;
+            }
+            last_frame = frame_number;
+        }
+
+        drawTiles();
+
+        bool last_worker;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last_worker = --busy_workers == 0;
+        }
+        if (last_worker)
+        {
+            frame_finished.notify_one();
+        }
+    }
+}
+
+/**
+* This method takes tiles and draws them until every tile has been taken.
+*/
+void TileRasterizer::drawTiles()
+{
+    int tile_count = tile_columns * tile_rows;
+    for (int tile = next_tile++; tile < tile_count; tile = next_tile++)
+    {
+        SDL_Rect clip_rect = { (tile % tile_columns) * TILE_SIZE, (tile / tile_columns) * TILE_SIZE, TILE_SIZE, TILE_SIZE };
+        for (auto index : bins[tile])
+        {
+            const Command& command = commands[index];
+            Blitter::blit(*frame, *command.image, command.whole_image ? nullptr : &command.source_rect, command.destination_rect, command.flip_horizontal, &clip_rect);
+        }
+    }
+}
\ No newline at end of file
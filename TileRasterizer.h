@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Blitter.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+* This class draws a frame on several threads. Draws are recorded instead of being done
+* straight away. When the frame is drawn, each draw is put in a bin for every tile of the
+* screen it touches, and then the threads take tiles one at a time and do the draws in
+* that tile's bin, clipped to the tile. Tiles never overlap, so the threads never write
+* to the same pixels, and the frame comes out exactly the same as drawing it on one thread.
+*
+* The thread that draws the frame works on tiles too, so one thread means no extra threads.
+*/
+class TileRasterizer
+{
+public:
+    TileRasterizer() = default;
+    ~TileRasterizer();
+
+    /**
+    * This method starts the worker threads. A thread count of 0 uses one thread
+    * per CPU core.
+    */
+    void start(const int thread_count);
+
+    /**
+    * This method stops the worker threads.
+    */
+    void stop();
+
+    /**
+    * This method records a draw of part of an image. The image must not change until
+    * the frame has been drawn.
+    */
+    void add(const Blitter::Image& image, const SDL_Rect* source_rect, const SDL_Rect& destination_rect, const bool flip_horizontal);
+
+    /**
+    * This method does every recorded draw onto a frame, and then forgets them.
+    */
+    void draw(Blitter::Image& frame);
+
+    /**
+    * This method returns whether there are any recorded draws.
+    */
+    bool isEmpty();
+
+    /**
+    * This method returns how many threads draw each frame, including the one that
+    * calls "draw".
+    */
+    int getThreadCount();
+
+public:
+    static const int TILE_SIZE = 64;
+
+private:
+    /**
+    * This struct holds one recorded draw.
+    */
+    struct Command
+    {
+        const Blitter::Image* image;
+        SDL_Rect source_rect;
+        SDL_Rect destination_rect;
+        bool whole_image;
+        bool flip_horizontal;
+    };
+
+    /**
+    * This method is run by each worker thread. It waits for a frame, and then
+    * draws tiles until there are none left.
+    */
+    void work();
+
+    /**
+    * This method takes tiles and draws them until every tile has been taken.
+    */
+    void drawTiles();
+
+private:
+    std::vector<Command> commands;
+
+    // The recorded draws that touch each tile, in the order they were recorded.
+    std::vector<std::vector<Uint32>> bins;
+    int tile_columns = 0;
+    int tile_rows = 0;
+    Blitter::Image* frame = nullptr;
+    std::atomic<int> next_tile{ 0 };
+
+    // Worker threads wait for the frame number to change, and the drawing thread waits
+    // for every worker to finish.
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable frame_started;
+    std::condition_variable frame_finished;
+    Uint64 frame_number = 0;
+    int busy_workers = 0;
+    bool stopping = false;
+};
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <cmath>
+
+TimerWheel::TimerWheel()
+{
+    std::fill(std::begin(first_wheel), std::end(first_wheel), NO_TIMER);
+    for (auto& wheel : upper_wheels)
+    {
+        std::fill(std::begin(wheel), std::end(wheel), NO_TIMER);
+    }
+}
+
+/**
+* This method returns something to "co_await" to wait for a number of seconds.
+*/
+TimerWheel::Delay TimerWheel::wait(const float seconds)
+{
+    return { *this, seconds };
+}
+
+/**
+* This method returns something to "co_await" to wait until "condition" is true. It
+* doesn't wait at all if the condition is already true.
+*/
+TimerWheel::Condition TimerWheel::waitUntil(const std::function<bool()>& condition, const float poll)
+{
+    return { *this, condition, poll };
+}
+
+/**
+* This method returns something to "co_await" to wait until "condition" is true. The
+* condition is checked whenever "event" is signalled, and every "poll" seconds in
+* case it changes without a signal.
+*/
+TimerWheel::Condition TimerWheel::waitUntil(const std::function<bool()>& condition, Event& event, const float poll)
+{
+    return { *this, condition, poll, &event };
+}
+
+/**
+* This method moves time forward, and resumes every coroutine whose timer is due.
+*/
+void TimerWheel::advance(const float seconds)
+{
+    resumed_count = 0;
+    time += seconds;
+    while (time >= TICK_LENGTH)
+    {
+        time -= TICK_LENGTH;
+        tick();
+    }
+}
+
+/**
+* This method stops a timer from resuming its coroutine. Timers that have already
+* fired are ignored.
+*/
+void TimerWheel::cancel(const Timer& timer)
+{
+    if (timer.index >= nodes.size() || nodes[timer.index].generation != timer.generation || !nodes[timer.index].handle)
+    {
+        return;
+    }
+
+    unlink(timer.index);
+    nodes[timer.index].handle = nullptr;
+    nodes[timer.index].generation++;
+    free_nodes.push_back(timer.index);
+    active_count--;
+}
+
+/**
+* This method makes a timer fire on the next tick instead of when it's due, and
+* returns false if it has already fired or been cancelled.
+*/
+bool TimerWheel::wake(const Timer& timer)
+{
+    if (timer.index >= nodes.size() || nodes[timer.index].generation != timer.generation || !nodes[timer.index].handle)
+    {
+        return false;
+    }
+
+    unlink(timer.index);
+    nodes[timer.index].expires = current_tick + 1;
+    insert(timer.index);
+    return true;
+}
+
+/**
+* This method makes every timer waiting on the event fire on the next tick,
+* and forgets the ones that have fired or been cancelled.
+*/
+void TimerWheel::Event::signal()
+{
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(), [](const auto& waiter) {
+        return !waiter.first->wake(waiter.second);
+    }), waiters.end());
+}
+
+/**
+* This method returns how many timers are waiting.
+*/
+std::size_t TimerWheel::size()
+{
+    return active_count;
+}
+
+/**
+* This method returns how many coroutines were resumed by the last call to "advance".
+*/
+std::size_t TimerWheel::getResumedCount()
+{
+    return resumed_count;
+}
+
+/**
+* This method adds a timer for a coroutine that will fire after "seconds". If there is
+* a condition, the timer keeps firing until it's true.
+*/
+TimerWheel::Timer TimerWheel::schedule(const std::coroutine_handle<> handle, const float seconds, Condition* condition)
+{
+    Uint32 index;
+    if (free_nodes.empty())
+    {
+        index = static_cast<Uint32>(nodes.size());
+        nodes.emplace_back();
+    }
+    else
+    {
+        index = free_nodes.back();
+        free_nodes.pop_back();
+    }
+
+    // A timer always waits at least one tick, so it never fires in the tick
+    // that's being handled.
+    Node& node = nodes[index];
+    node.handle = handle;
+    node.condition = condition;
+    node.expires = current_tick + std::max<Uint64>(1, static_cast<Uint64>(std::ceil(seconds / TICK_LENGTH)));
+    insert(index);
+    active_count++;
+
+    return { index, node.generation };
+}
+
+/**
+* This method moves the wheel on by one tick, and fires every timer in the tick's slot.
+*/
+void TimerWheel::tick()
+{
+    current_tick++;
+
+    // When a wheel comes round, the next slot of the wheel above it is moved down.
+    int slot = static_cast<int>(current_tick & (FIRST_WHEEL_SIZE - 1));
+    if (slot == 0)
+    {
+        for (int wheel = 0; wheel < WHEEL_COUNT - 1; wheel++)
+        {
+            int upper_slot = static_cast<int>((current_tick >> (FIRST_WHEEL_BITS + (wheel * WHEEL_BITS))) & (WHEEL_SIZE - 1));
+            cascade(wheel, upper_slot);
+            if (upper_slot != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Resuming a coroutine can add and cancel timers, so the due timers are collected
+    // before any of them are fired.
+    due.clear();
+    for (Uint32 index = first_wheel[slot]; index != NO_TIMER; index = nodes[index].next)
+    {
+        due.push_back({ index, nodes[index].generation });
+    }
+
+    for (const auto& timer : due)
+    {
+        Node& node = nodes[timer.index];
+        if (node.generation != timer.generation || !node.handle)
+        {
+            continue;
+        }
+
+        unlink(timer.index);
+        if (node.condition != nullptr && !node.condition->condition())
+        {
+            node.expires = current_tick + std::max<Uint64>(1, static_cast<Uint64>(std::ceil(node.condition->poll / TICK_LENGTH)));
+            insert(timer.index);
+            continue;
+        }
+
+        std::coroutine_handle<> handle = node.handle;
+        node.handle = nullptr;
+        node.generation++;
+        free_nodes.push_back(timer.index);
+        active_count--;
+        resumed_count++;
+        handle.resume();
+    }
+}
+
+/**
+* This method puts a timer in the slot for when it expires.
+*/
+void TimerWheel::insert(const Uint32 index)
+{
+    Node& node = nodes[index];
+    Uint64 ticks = node.expires - current_tick;
+
+    // Timers too far away for every wheel go in the last slot of the last wheel.
+    Uint32* head;
+    if (ticks < FIRST_WHEEL_SIZE)
+    {
+        head = &first_wheel[node.expires & (FIRST_WHEEL_SIZE - 1)];
+    }
+    else
+    {
+        int wheel = 0;
+        while (wheel < WHEEL_COUNT - 2 && ticks >= (Uint64(1) << (FIRST_WHEEL_BITS + ((wheel + 1) * WHEEL_BITS))))
+        {
+            wheel++;
+        }
+
+        Uint64 limit = Uint64(1) << (FIRST_WHEEL_BITS + ((wheel + 1) * WHEEL_BITS));
+        if (ticks >= limit)
+        {
+            node.expires = current_tick + limit - 1;
+        }
+        head = &upper_wheels[wheel][(node.expires >> (FIRST_WHEEL_BITS + (wheel * WHEEL_BITS))) & (WHEEL_SIZE - 1)];
+    }
+
+    node.head = head;
+    node.previous = NO_TIMER;
+    node.next = *head;
+    if (*head != NO_TIMER)
+    {
+        nodes[*head].previous = index;
+    }
+    *head = index;
+}
+
+/**
+* This method takes a timer out of its slot.
+*/
+void TimerWheel::unlink(const Uint32 index)
+{
+    Node& node = nodes[index];
+    if (node.previous != NO_TIMER)
+    {
+        nodes[node.previous].next = node.next;
+    }
+    else
+    {
+        *node.head = node.next;
+    }
+    if (node.next != NO_TIMER)
+    {
+        nodes[node.next].previous = node.previous;
+    }
+    node.previous = NO_TIMER;
+    node.next = NO_TIMER;
+}
+
+/**
+* This method moves every timer in a slot of one of the upper wheels down to the
+* wheels below.
+*/
+void TimerWheel::cascade(const int wheel, const int slot)
+{
+    Uint32 index = upper_wheels[wheel][slot];
+    upper_wheels[wheel][slot] = NO_TIMER;
+    while (index != NO_TIMER)
+    {
+        Uint32 next = nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
\ No newline at end of file
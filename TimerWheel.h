@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Application.h"
+#include <coroutine>
+#include <functional>
+
+/**
+* This class resumes coroutines after a delay, or once a condition is true. A condition
+* can be waited on along with an event, so it's checked as soon as the event is signalled
+* instead of waiting for the next poll. Timers are
+* kept in a hierarchical timer wheel. The first wheel has a slot for each tick over the
+* next few seconds, and each wheel after it has slots covering a whole turn of the wheel
+* before it. When a wheel comes round, the timers in its next slot are moved down to the
+* wheel below.
+*
+* Advancing the wheel only looks at the slots for the ticks that have passed, so it costs
+* the same however many timers are waiting, plus the work for the timers that are due.
+*
+* Timers are kept in a pool and reused, so scheduling doesn't allocate any memory once
+* the pool is big enough.
+*/
+class TimerWheel
+{
+public:
+    /**
+    * This struct refers to a timer. The generation changes every time a timer in
+    * the pool is reused, so an old timer is never cancelled by mistake.
+    */
+    struct Timer
+    {
+        Uint32 index = NO_TIMER;
+        Uint32 generation = 0;
+    };
+
+    /**
+    * This struct is awaited by a coroutine to suspend it for a number of seconds.
+    */
+    struct Delay
+    {
+        TimerWheel& wheel;
+        float seconds;
+
+        bool await_ready()
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            handle.promise().wheel = &wheel;
+            handle.promise().timer = wheel.schedule(handle, seconds, nullptr);
+        }
+
+        void await_resume()
+        {
+        }
+    };
+
+    /**
+    * This struct holds the timers waiting on something that happens now and then.
+    * Signalling it makes each of them check its condition on the next tick, so they
+    * only need to poll in case a signal is missed. A timer waits on the event until
+    * it fires or is cancelled, so it's woken again if its condition is still false.
+    */
+    struct Event
+    {
+        std::vector<std::pair<TimerWheel*, Timer>> waiters;
+
+        /**
+        * This method makes every timer waiting on the event fire on the next tick,
+        * and forgets the ones that have fired or been cancelled.
+        */
+        void signal();
+    };
+
+    /**
+    * This struct is awaited by a coroutine to suspend it until a condition is true.
+    * The condition is checked every "poll" seconds, and whenever the event is
+    * signalled if there is one.
+    */
+    struct Condition
+    {
+        TimerWheel& wheel;
+        std::function<bool()> condition;
+        float poll;
+        Event* event = nullptr;
+
+        bool await_ready()
+        {
+            return condition();
+        }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            handle.promise().wheel = &wheel;
+            handle.promise().timer = wheel.schedule(handle, poll, this);
+            if (event != nullptr)
+            {
+                event->waiters.push_back({ &wheel, handle.promise().timer });
+            }
+        }
+
+        void await_resume()
+        {
+        }
+    };
+
+public:
+    TimerWheel();
+
+    /**
+    * This method returns something to "co_await" to wait for a number of seconds.
+    */
+    Delay wait(const float seconds);
+
+    /**
+    * This method returns something to "co_await" to wait until "condition" is true. It
+    * doesn't wait at all if the condition is already true.
+    */
+    Condition waitUntil(const std::function<bool()>& condition, const float poll);
+
+    /**
+    * This method returns something to "co_await" to wait until "condition" is true. The
+    * condition is checked whenever "event" is signalled, and every "poll" seconds in
+    * case it changes without a signal.
+    */
+    Condition waitUntil(const std::function<bool()>& condition, Event& event, const float poll);
+
+    /**
+    * This method moves time forward, and resumes every coroutine whose timer is due.
+    */
+    void advance(const float seconds);
+
+    /**
+    * This method stops a timer from resuming its coroutine. Timers that have already
+    * fired are ignored.
+    */
+    void cancel(const Timer& timer);
+
+    /**
+    * This method makes a timer fire on the next tick instead of when it's due, and
+    * returns false if it has already fired or been cancelled.
+    */
+    bool wake(const Timer& timer);
+
+    /**
+    * This method returns how many timers are waiting.
+    */
+    std::size_t size();
+
+    /**
+    * This method returns how many coroutines were resumed by the last call to "advance".
+    */
+    std::size_t getResumedCount();
+
+private:
+    /**
+    * This method adds a timer for a coroutine that will fire after "seconds". If there is
+    * a condition, the timer keeps firing until it's true.
+    */
+    Timer schedule(const std::coroutine_handle<> handle, const float seconds, Condition* condition);
+
+    /**
+    * This method moves the wheel on by one tick, and fires every timer in the tick's slot.
+    */
+    void tick();
+
+    /**
+    * This method puts a timer in the slot for when it expires.
+    */
+    void insert(const Uint32 index);
+
+    /**
+    * This method takes a timer out of its slot.
+    */
+    void unlink(const Uint32 index);
+
+    /**
+    * This method moves every timer in a slot of one of the upper wheels down to the
+    * wheels below.
+    */
+    void cascade(const int wheel, const int slot);
+
+private:
+    static constexpr Uint32 NO_TIMER = 0xFFFFFFFF;
+    static constexpr float TICK_LENGTH = 0.01f;
+    static const int WHEEL_COUNT = 3;
+    static const int FIRST_WHEEL_BITS = 8;
+    static const int WHEEL_BITS = 6;
+    static const int FIRST_WHEEL_SIZE = 1 << FIRST_WHEEL_BITS;
+    static const int WHEEL_SIZE = 1 << WHEEL_BITS;
+
+    /**
+    * This struct holds one timer in the pool. Timers in the same slot are linked
+    * together in a list.
+    */
+    struct Node
+    {
+        std::coroutine_handle<> handle;
+        Condition* condition = nullptr;
+        Uint64 expires = 0;
+        Uint32 generation = 0;
+        Uint32 previous = NO_TIMER;
+        Uint32 next = NO_TIMER;
+        Uint32* head = nullptr;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Uint32> free_nodes;
+    std::size_t active_count = 0;
+
+    // The first timer in every slot of every wheel.
+    Uint32 first_wheel[FIRST_WHEEL_SIZE] = {};
+    Uint32 upper_wheels[WHEEL_COUNT - 1][WHEEL_SIZE] = {};
+
+    Uint64 current_tick = 0;
+    float time = 0.0;
+    std::size_t resumed_count = 0;
+
+    // The timers that are due this tick. This is reused by every tick.
+    std::vector<Timer> due;
+};
+
+/**
+* This struct is the return type of a coroutine that's driven by a timer wheel. It starts
+* running straight away, and owns the coroutine, so destroying it destroys the coroutine
+* and cancels whatever the coroutine was waiting for.
+*/
+struct Behaviour
+{
+    struct promise_type
+    {
+        TimerWheel* wheel = nullptr;
+        TimerWheel::Timer timer;
+
+        Behaviour get_return_object()
+        {
+            return Behaviour(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_never initial_suspend()
+        {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            throw;
+        }
+    };
+
+    Behaviour() = default;
+
+    explicit Behaviour(std::coroutine_handle<promise_type> handle) : handle(handle)
+    {
+    }
+
+    Behaviour(Behaviour&& other) noexcept : handle(other.handle)
+    {
+        other.handle = nullptr;
+    }
+
+    Behaviour& operator=(Behaviour&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+
+    ~Behaviour()
+    {
+        reset();
+    }
+
+    /**
+    * This method destroys the coroutine, if there is one.
+    */
+    void reset()
+    {
+        if (handle)
+        {
+            if (handle.promise().wheel != nullptr)
+            {
+                handle.promise().wheel->cancel(handle.promise().timer);
+            }
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
\ No newline at end of file
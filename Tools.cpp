@@ -41,22 +41,29 @@ namespace Tools
     }
 
     /**
-    * This function returns a random float between "from" and "to".
+    * This function seeds the random number generator. The same seed always produces
+    * the same sequence of random numbers, which is what makes replays possible.
+    */
+    void seedRandom(const unsigned int seed)
+    {
+        Random::seed(seed);
+    }
+
+    /**
+    * This function returns a random float between "from" and "to". It uses the
+    * simulation stream, so it must only be called from the game thread.
     */
     float randomFloat(const float from, const float to)
     {
-        static std::default_random_engine engine(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-        std::uniform_real_distribution<float> dist(from, to);
-        return dist(engine);
+        return Random::getStream(Random::Stream::Simulation).nextFloat(from, to);
     }
 
     /**
-    * This function returns a random int between "from" and "to".
+    * This function returns a random int between "from" and "to". It uses the
+    * simulation stream, so it must only be called from the game thread.
     */
     int randomInt(const int from, const int to)
     {
-        static std::default_random_engine engine(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-        std::uniform_int_distribution<int> dist(from, to);
-        return dist(engine);
+        return Random::getStream(Random::Stream::Simulation).nextInt(from, to);
     }
 }
\ No newline at end of file
@@ -4,8 +4,7 @@
 #include <sstream>
 #include <vector>
 #include <cmath>
-#include <random>
-#include <chrono>
+#include "Random.h"
 
 /**
 * This namespace contains miscellaneous helpful functions.
@@ -35,12 +34,20 @@ namespace Tools
     FloatVector normalizeVector(const FloatVector& vector);
 
     /**
-    * This function returns a random float between "from" and "to".
+    * This function seeds the random number generator. The same seed always produces
+    * the same sequence of random numbers, which is what makes replays possible.
+    */
+    void seedRandom(const unsigned int seed);
+
+    /**
+    * This function returns a random float between "from" and "to". It uses the
+    * simulation stream, so it must only be called from the game thread.
     */
     float randomFloat(const float from, const float to);
 
     /**
-    * This function returns a random int between "from" and "to".
+    * This function returns a random int between "from" and "to". It uses the
+    * simulation stream, so it must only be called from the game thread.
     */
     int randomInt(const int from, const int to);
 }
\ No newline at end of file
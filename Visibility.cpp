@@ -0,0 +1,490 @@
+#include "Visibility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+* This method throws away every set and starts again with new level geometry. "solids"
+* is the level's grid, where '1' is solid. The grid must outlive this object.
+*/
+void Visibility::setSolids(const std::vector<std::string>& solids, const int tile_size)
+{
+    this->solids = &solids;
+    this->tile_size = tile_size;
+    height = static_cast<int>(solids.size());
+    width = height > 0 ? static_cast<int>(solids[0].size()) : 0;
+    reset();
+}
+
+/**
+* This method throws away every set, keeping the level geometry.
+*/
+void Visibility::reset()
+{
+    offsets.assign(width * height, NOT_BUILT);
+    bits.clear();
+    stamps.assign(width * height, 0);
+    current_stamp = 0;
+    built_count = 0;
+    build_time = 0.0;
+}
+
+/**
+* This method builds the set of every floor tile.
+*/
+void Visibility::buildAll()
+{
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            if (!isSolid(x, y) && offsets[y * width + x] == NOT_BUILT)
+            {
+                build(x, y);
+            }
+        }
+    }
+}
+
+/**
+* This method determines if any part of one tile can be seen from the other. Tiles
+* outside the level or inside solids are always treated as visible.
+*/
+bool Visibility::isVisible(const SDL_Point& from_tile, const SDL_Point& to_tile)
+{
+    if (isSolid(from_tile.x, from_tile.y) || isSolid(to_tile.x, to_tile.y))
+    {
+        return true;
+    }
+
+    Uint32 offset = offsets[from_tile.y * width + from_tile.x];
+    if (offset == NOT_BUILT)
+    {
+        build(from_tile.x, from_tile.y);
+        offset = offsets[from_tile.y * width + from_tile.x];
+    }
+
+    // Unpack the rectangle, and check the tile is inside it before checking its bit.
+    Uint64 header = bits[offset];
+    int box_x = static_cast<int>(header & 0xFFFF);
+    int box_y = static_cast<int>((header >> 16) & 0xFFFF);
+    int box_w = static_cast<int>((header >> 32) & 0xFFFF);
+    int box_h = static_cast<int>((header >> 48) & 0xFFFF);
+
+    int x = to_tile.x - box_x;
+    int y = to_tile.y - box_y;
+    if (x < 0 || y < 0 || x >= box_w || y >= box_h)
+    {
+        return false;
+    }
+
+    std::size_t bit = (y * box_w) + x;
+    return (bits[offset + 1 + (bit / 64)] >> (bit % 64)) & 1;
+}
+
+/**
+* This method determines if a line between two points doesn't pass through any
+* solid tiles. It walks along the tiles the line passes through.
+*/
+bool Visibility::traceLine(const SDL_Point& from, const SDL_Point& to)
+{
+    // Points are the centres of pixels.
+    double x1 = from.x + 0.5;
+    double y1 = from.y + 0.5;
+    double x2 = to.x + 0.5;
+    double y2 = to.y + 0.5;
+
+    int x = static_cast<int>(std::floor(x1 / tile_size));
+    int y = static_cast<int>(std::floor(y1 / tile_size));
+    int end_x = static_cast<int>(std::floor(x2 / tile_size));
+    int end_y = static_cast<int>(std::floor(y2 / tile_size));
+    if (isSolid(x, y))
+    {
+        return false;
+    }
+
+    // How far along the line the next tile edge is on each axis, and how far along the
+    // line one whole tile is on each axis.
+    const double INFINITE = std::numeric_limits<double>::infinity();
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    int step_x = dx > 0 ? 1 : -1;
+    int step_y = dy > 0 ? 1 : -1;
+    double next_x = dx != 0 ? (((x + (step_x > 0 ? 1 : 0)) * tile_size) - x1) / dx : INFINITE;
+    double next_y = dy != 0 ? (((y + (step_y > 0 ? 1 : 0)) * tile_size) - y1) / dy : INFINITE;
+    double delta_x = dx != 0 ? tile_size / std::abs(dx) : INFINITE;
+    double delta_y = dy != 0 ? tile_size / std::abs(dy) : INFINITE;
+
+    int steps = std::abs(end_x - x) + std::abs(end_y - y);
+    while (steps > 0 && (x != end_x || y != end_y))
+    {
+        if (next_x < next_y)
+        {
+            x += step_x;
+            next_x += delta_x;
+            steps--;
+        }
+        else if (next_y < next_x)
+        {
+            y += step_y;
+            next_y += delta_y;
+            steps--;
+        }
+        else
+        {
+            // The line goes exactly through a corner, so it can't squeeze between
+            // two tiles that are only touching at the corner.
+            if (isSolid(x + step_x, y) || isSolid(x, y + step_y))
+            {
+                return false;
+            }
+            x += step_x;
+            y += step_y;
+            next_x += delta_x;
+            next_y += delta_y;
+            steps -= 2;
+        }
+
+        if (isSolid(x, y))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+* This method returns how many bytes the sets use.
+*/
+std::size_t Visibility::getMemory()
+{
+    return (offsets.size() * sizeof(Uint32)) + (bits.size() * sizeof(Uint64));
+}
+
+/**
+* This method returns how many sets have been built.
+*/
+int Visibility::getBuiltCount()
+{
+    return built_count;
+}
+
+/**
+* This method returns how long building the sets has taken, in seconds.
+*/
+float Visibility::getBuildTime()
+{
+    return build_time;
+}
+
+/**
+* This method builds the set of a single tile.
+*/
+void Visibility::build(const int x, const int y)
+{
+    Uint64 start_time = SDL_GetPerformanceCounter();
+
+    // The tiles that can be seen from a tile are all connected, so a flood fill that
+    // only spreads through visible tiles finds all of them without checking the rest.
+    if (++current_stamp == 0)
+    {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        current_stamp = 1;
+    }
+    frontier.clear();
+    visible.clear();
+    frontier.push_back({ x, y });
+    stamps[y * width + x] = current_stamp;
+
+    SDL_Point minimum = { x, y };
+    SDL_Point maximum = { x, y };
+    while (!frontier.empty())
+    {
+        SDL_Point tile = frontier.back();
+        frontier.pop_back();
+        visible.push_back(tile);
+        minimum = { std::min(minimum.x, tile.x), std::min(minimum.y, tile.y) };
+        maximum = { std::max(maximum.x, tile.x), std::max(maximum.y, tile.y) };
+
+        for (int ny = tile.y - 1; ny <= tile.y + 1; ny++)
+        {
+            for (int nx = tile.x - 1; nx <= tile.x + 1; nx++)
+            {
+                if (isSolid(nx, ny) || stamps[ny * width + nx] == current_stamp)
+                {
+                    continue;
+                }
+                stamps[ny * width + nx] = current_stamp;
+                if (canTileSeeTile(x, y, nx, ny))
+                {
+                    frontier.push_back({ nx, ny });
+                }
+            }
+        }
+    }
+
+    // Pack the rectangle into the first word, and then set a bit for every visible tile.
+    int box_w = (maximum.x - minimum.x) + 1;
+    int box_h = (maximum.y - minimum.y) + 1;
+    Uint32 offset = static_cast<Uint32>(bits.size());
+    bits.push_back(static_cast<Uint64>(minimum.x) | (static_cast<Uint64>(minimum.y) << 16) | (static_cast<Uint64>(box_w) << 32) | (static_cast<Uint64>(box_h) << 48));
+    bits.resize(bits.size() + (((box_w * box_h) + 63) / 64), 0);
+    for (const auto& tile : visible)
+    {
+        std::size_t bit = ((tile.y - minimum.y) * box_w) + (tile.x - minimum.x);
+        bits[offset + 1 + (bit / 64)] |= Uint64(1) << (bit % 64);
+    }
+    offsets[y * width + x] = offset;
+
+    built_count++;
+    build_time += static_cast<float>(SDL_GetPerformanceCounter() - start_time) / SDL_GetPerformanceFrequency();
+}
+
+/**
+* This method determines if any part of one tile might be seen from any part of
+* another. It only returns false when it's certain that every line is blocked.
+*/
+bool Visibility::canTileSeeTile(const int from_x, const int from_y, const int to_x, const int to_y)
+{
+    // Most tiles that can see each other are found by tracing between the centre and
+    // the four corners, moved in by a pixel so they're inside the tile.
+    const int OFFSETS[SAMPLE_COUNT][2] = {
+        { tile_size / 2, tile_size / 2 },
+        { 1, 1 },
+        { tile_size - 2, 1 },
+        { 1, tile_size - 2 },
+        { tile_size - 2, tile_size - 2 }
+    };
+
+    for (const auto& from_offset : OFFSETS)
+    {
+        SDL_Point from = { (from_x * tile_size) + from_offset[0], (from_y * tile_size) + from_offset[1] };
+        for (const auto& to_offset : OFFSETS)
+        {
+            SDL_Point to = { (to_x * tile_size) + to_offset[0], (to_y * tile_size) + to_offset[1] };
+            if (traceLine(from, to))
+            {
+                return true;
+            }
+        }
+    }
+
+    // Otherwise they can only be ruled out if it's certain they can't see each other.
+    return !isBlockedBetween(from_x, from_y, to_x, to_y, 0) && !isBlockedBetween(from_x, from_y, to_x, to_y, 1);
+}
+
+/**
+* This method determines if the solids in the columns between two tiles block every
+* line from one to the other. "axis" is 0 to use the columns, and 1 to use the rows.
+*/
+bool Visibility::isBlockedBetween(const int from_x, const int from_y, const int to_x, const int to_y, const int axis)
+{
+    // Lines are "across = (slope * (along - pivot)) + offset", and the tile nearest the
+    // start of the axis comes first. Tiles with no columns between them can't be ruled
+    // out.
+    int other_axis = 1 - axis;
+    int first[2] = { from_x, from_y };
+    int second[2] = { to_x, to_y };
+    bool swapped = first[axis] > second[axis];
+    if (swapped)
+    {
+        std::swap(first, second);
+    }
+    if (second[axis] - first[axis] < 2)
+    {
+        return false;
+    }
+
+    // Lines start at the centre of a pixel, so the tile being seen from only covers
+    // the centres of its pixels. The other tile covers all of it, so that a line that
+    // can be seen is also seen all the way to every tile it passes through.
+    Box from;
+    Box to;
+    for (int i = 0; i < 2; i++)
+    {
+        from.minimum[i] = first[i] * tile_size;
+        from.maximum[i] = (first[i] + 1) * tile_size;
+        to.minimum[i] = second[i] * tile_size;
+        to.maximum[i] = (second[i] + 1) * tile_size;
+    }
+    Box& seen_from = swapped ? to : from;
+    for (int i = 0; i < 2; i++)
+    {
+        seen_from.minimum[i] += 0.5;
+        seen_from.maximum[i] -= 0.5;
+    }
+
+    // Only the solids strictly between the tiles are used, so every line from one tile
+    // to the other goes all the way across them, and only the tiles in each column
+    // that a line could go through. Solids next to each other in a column are joined
+    // up, so lines can't slip between them. The furthest a line can go across a
+    // column either way is along a line between corners on that side of the tiles.
+    double corner_slopes[2][4];
+    double corner_offsets[2][4];
+    for (int side = 0; side < 2; side++)
+    {
+        double from_across = side == 0 ? from.minimum[other_axis] : from.maximum[other_axis];
+        double to_across = side == 0 ? to.minimum[other_axis] : to.maximum[other_axis];
+        for (int corner = 0; corner < 4; corner++)
+        {
+            double from_along = corner & 1 ? from.maximum[axis] : from.minimum[axis];
+            double to_along = corner & 2 ? to.maximum[axis] : to.minimum[axis];
+            corner_slopes[side][corner] = (to_across - from_across) / (to_along - from_along);
+            corner_offsets[side][corner] = from_across - (corner_slopes[side][corner] * from_along);
+        }
+    }
+
+    runs.clear();
+    for (int line = first[axis] + 1; line < second[axis]; line++)
+    {
+        double across_lowest = std::numeric_limits<double>::infinity();
+        double across_highest = -across_lowest;
+        for (int edge = line; edge <= line + 1; edge++)
+        {
+            for (int corner = 0; corner < 4; corner++)
+            {
+                across_lowest = std::min(across_lowest, (corner_slopes[0][corner] * edge * tile_size) + corner_offsets[0][corner]);
+                across_highest = std::max(across_highest, (corner_slopes[1][corner] * edge * tile_size) + corner_offsets[1][corner]);
+            }
+        }
+
+        // One more tile each way, so a line along the edge still goes through the
+        // inside of a run that carries on past it.
+        int across_start = static_cast<int>(std::floor(across_lowest / tile_size)) - 1;
+        int across_end = static_cast<int>(std::floor(across_highest / tile_size)) + 1;
+        int run_start = -1;
+        for (int tile = across_start; tile <= across_end + 1; tile++)
+        {
+            bool solid = tile <= across_end && (axis == 0 ? isSolid(line, tile) : isSolid(tile, line));
+            if (solid && run_start < 0)
+            {
+                run_start = tile;
+            }
+            else if (!solid && run_start >= 0)
+            {
+                Box run;
+                run.minimum[axis] = line * tile_size;
+                run.maximum[axis] = (line + 1) * tile_size;
+                run.minimum[other_axis] = run_start * tile_size;
+                run.maximum[other_axis] = tile * tile_size;
+                runs.push_back(run);
+                run_start = -1;
+            }
+        }
+    }
+    if (runs.empty())
+    {
+        return false;
+    }
+
+    // The steepest and shallowest lines between the tiles go between their corners.
+    double low = std::numeric_limits<double>::infinity();
+    double high = -low;
+    for (int corner = 0; corner < 16; corner++)
+    {
+        double from_along = corner & 1 ? from.maximum[axis] : from.minimum[axis];
+        double from_across = corner & 2 ? from.maximum[other_axis] : from.minimum[other_axis];
+        double to_along = corner & 4 ? to.maximum[axis] : to.minimum[axis];
+        double to_across = corner & 8 ? to.maximum[other_axis] : to.minimum[other_axis];
+        double slope = (to_across - from_across) / (to_along - from_along);
+        low = std::min(low, slope);
+        high = std::max(high, slope);
+    }
+
+    int searches = SEARCH_LIMIT;
+    return isRangeBlocked(from, to, axis, low, high, searches);
+}
+
+/**
+* This method determines if every line with a slope from "low" to "high" that meets
+* both boxes goes through one of the runs of solids. It splits the slopes in half
+* until it's certain or "searches" runs out.
+*/
+bool Visibility::isRangeBlocked(const Box& from, const Box& to, const int axis, const double low, const double high, int& searches)
+{
+    // The offsets of the lines that meet a box are a range that moves in a straight
+    // line as the slope changes, as long as the slope doesn't change sign.
+    if (low < 0.0 && high > 0.0)
+    {
+        return isRangeBlocked(from, to, axis, low, 0.0, searches) && isRangeBlocked(from, to, axis, 0.0, high, searches);
+    }
+    // Offsets are measured halfway between the tiles, so they barely move when the
+    // slope changes a little.
+    int other_axis = 1 - axis;
+    double pivot = (from.maximum[axis] + to.minimum[axis]) / 2.0;
+    auto lowest_offset = [&](const Box& box, const double slope) {
+        return box.minimum[other_axis] - (slope >= 0.0 ? slope * (box.maximum[axis] - pivot) : slope * (box.minimum[axis] - pivot));
+    };
+    auto highest_offset = [&](const Box& box, const double slope) {
+        return box.maximum[other_axis] - (slope >= 0.0 ? slope * (box.minimum[axis] - pivot) : slope * (box.maximum[axis] - pivot));
+    };
+
+    // Every line that meets both tiles has an offset in this range.
+    double start = std::max(std::min(lowest_offset(from, low), lowest_offset(from, high)), std::min(lowest_offset(to, low), lowest_offset(to, high)));
+    double end = std::min(std::max(highest_offset(from, low), highest_offset(from, high)), std::max(highest_offset(to, low), highest_offset(to, high)));
+    if (start > end)
+    {
+        return true;
+    }
+
+    // The offsets that go through the inside of a run, whatever the slope. Lines that
+    // only touch the edge of a run aren't blocked by it, so the ranges have to overlap.
+    covered.clear();
+    for (const auto& run : runs)
+    {
+        double run_start = std::max(lowest_offset(run, low), lowest_offset(run, high));
+        double run_end = std::min(highest_offset(run, low), highest_offset(run, high));
+        if (run_start < run_end)
+        {
+            covered.push_back({ run_start, run_end });
+        }
+    }
+    std::sort(covered.begin(), covered.end());
+
+    double reached = start;
+    double gap_end = end;
+    for (const auto& range : covered)
+    {
+        if (range.first >= reached)
+        {
+            gap_end = std::min(range.first, end);
+            break;
+        }
+        reached = std::max(reached, range.second);
+        if (reached > end)
+        {
+            return true;
+        }
+    }
+
+    // A line through the middle of the first gap might not go through any run, and
+    // then some part of each tile can see the other.
+    double slope = (low + high) / 2.0;
+    double offset = (reached + gap_end) / 2.0;
+    bool clear = offset >= std::max(lowest_offset(from, slope), lowest_offset(to, slope)) && offset <= std::min(highest_offset(from, slope), highest_offset(to, slope));
+    for (std::size_t i = 0; i < runs.size() && clear; i++)
+    {
+        clear = offset <= lowest_offset(runs[i], slope) || offset >= highest_offset(runs[i], slope);
+    }
+    if (clear)
+    {
+        return false;
+    }
+
+    if (--searches <= 0)
+    {
+        return false;
+    }
+    double middle = (low + high) / 2.0;
+    return isRangeBlocked(from, to, axis, low, middle, searches) && isRangeBlocked(from, to, axis, middle, high, searches);
+}
+
+/**
+* This method determines if a tile is solid. Tiles outside the level are solid.
+*/
+bool Visibility::isSolid(const int x, const int y)
+{
+    return x < 0 || y < 0 || x >= width || y >= height || (*solids)[y][x] == '1';
+}
\ No newline at end of file
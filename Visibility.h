@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Application.h"
+
+/**
+* This class holds a potentially visible set for a level. For every floor tile it stores
+* which other tiles can be seen from anywhere on that tile, so most line of sight checks
+* are a single bit test. Only lines between tiles that can see each other have to be traced.
+*
+* Each tile's set only covers the smallest rectangle holding every tile it can see, which
+* keeps the sets small in levels made of corridors and rooms. Sets are built the first time
+* they are needed, or all at once with "buildAll".
+*
+* A tile can see another tile if a line between any of a handful of points spread over
+* both tiles is clear. If none is, the tiles are only ruled out once it's certain that
+* the solids between them block every line from one to the other. Anything it can't
+* decide is treated as visible, so a line that only just scrapes through a gap is never
+* ruled out, and the set only ever has too many tiles.
+*/
+class Visibility
+{
+public:
+    /**
+    * This method throws away every set and starts again with new level geometry. "solids"
+    * is the level's grid, where '1' is solid. The grid must outlive this object.
+    */
+    void setSolids(const std::vector<std::string>& solids, const int tile_size);
+
+    /**
+    * This method throws away every set, keeping the level geometry.
+    */
+    void reset();
+
+    /**
+    * This method builds the set of every floor tile.
+    */
+    void buildAll();
+
+    /**
+    * This method determines if any part of one tile can be seen from the other. Tiles
+    * outside the level or inside solids are always treated as visible.
+    */
+    bool isVisible(const SDL_Point& from_tile, const SDL_Point& to_tile);
+
+    /**
+    * This method determines if a line between two points doesn't pass through any
+    * solid tiles. It walks along the tiles the line passes through.
+    */
+    bool traceLine(const SDL_Point& from, const SDL_Point& to);
+
+    /**
+    * This method returns how many bytes the sets use.
+    */
+    std::size_t getMemory();
+
+    /**
+    * This method returns how many sets have been built.
+    */
+    int getBuiltCount();
+
+    /**
+    * This method returns how long building the sets has taken, in seconds.
+    */
+    float getBuildTime();
+
+private:
+    /**
+    * This method builds the set of a single tile.
+    */
+    void build(const int x, const int y);
+
+    /**
+    * This struct holds a rectangle in pixels, which is either a tile or a run of solid tiles.
+    */
+    struct Box
+    {
+        double minimum[2];
+        double maximum[2];
+    };
+
+    /**
+    * This method determines if any part of one tile might be seen from any part of
+    * another. It only returns false when it's certain that every line is blocked.
+    */
+    bool canTileSeeTile(const int from_x, const int from_y, const int to_x, const int to_y);
+
+    /**
+    * This method determines if the solids in the columns between two tiles block every
+    * line from one to the other. "axis" is 0 to use the columns, and 1 to use the rows.
+    */
+    bool isBlockedBetween(const int from_x, const int from_y, const int to_x, const int to_y, const int axis);
+
+    /**
+    * This method determines if every line with a slope from "low" to "high" that meets
+    * both boxes goes through one of the runs of solids. It splits the slopes in half
+    * until it's certain or "searches" runs out.
+    */
+    bool isRangeBlocked(const Box& from, const Box& to, const int axis, const double low, const double high, int& searches);
+
+    /**
+    * This method determines if a tile is solid. Tiles outside the level are solid.
+    */
+    bool isSolid(const int x, const int y);
+
+private:
+    static constexpr Uint32 NOT_BUILT = 0xFFFFFFFF;
+    static const int SAMPLE_COUNT = 5;
+    static const int SEARCH_LIMIT = 64;
+
+    const std::vector<std::string>* solids = nullptr;
+    int tile_size = 1;
+    int width = 0;
+    int height = 0;
+
+    // For each tile, where its set starts in "bits". Each set starts with a word holding
+    // its rectangle, followed by one bit per tile in the rectangle.
+    std::vector<Uint32> offsets;
+    std::vector<Uint64> bits;
+
+    // These are reused by every build. A tile has been visited in the current build
+    // if its stamp matches "current_stamp".
+    std::vector<Uint32> stamps;
+    Uint32 current_stamp = 0;
+    std::vector<SDL_Point> frontier;
+    std::vector<SDL_Point> visible;
+    std::vector<Box> runs;
+    std::vector<std::pair<double, double>> covered;
+
+    int built_count = 0;
+    float build_time = 0.0;
+};
\ No newline at end of file
@@ -1,6 +1,14 @@
 #include "MainMenuState.h"
 #include "GameState.h"
 #include "OptionsMenuState.h"
+#include "Replay.h"
+#include "Autopilot.h"
+#include "SpriteCache.h"
+#include "Compositor.h"
+#include "RenderThread.h"
+#include "DynamicResolution.h"
+#include "Background.h"
+#include "TextureCache.h"
 
 int main(int argc, char* argv[])
 {
@@ -12,7 +20,32 @@ int main(int argc, char* argv[])
         int width = atoi(size[0].c_str());
         int height = atoi(size[1].c_str());
 
-        Application::startUp("Top Down WW2", width, height, 1024, 576, fullscreen, 60);
+        // The render thread has to be running before the renderer is created, so it can own it.
+        if (Application::getConfigMap()["graphics"]["render_thread"] == "On")
+        {
+            RenderThread::start();
+        }
+        bool vsync = Application::getConfigMap()["graphics"]["vsync"] == "On";
+        Application::startUp("Top Down WW2", width, height, 1024, 576, fullscreen, 60, vsync);
+
+        // The compositor is off unless it's turned on. Rotated sprites default to "Auto", which
+        // only uses them with the software renderer or the compositor.
+        std::string compositor = Application::getConfigMap()["graphics"]["compositor"];
+        int render_threads = atoi(Application::getConfigMap()["graphics"]["render_threads"].c_str());
+        Compositor::setup(compositor == "On" ? Compositor::Mode::On : compositor == "Auto" ? Compositor::Mode::Auto : Compositor::Mode::Off, render_threads);
+
+        std::string rotated_sprites = Application::getConfigMap()["graphics"]["rotated_sprites"];
+        int rotations = atoi(Application::getConfigMap()["graphics"]["rotations"].c_str());
+        SpriteCache::setup(rotated_sprites == "On" ? SpriteCache::Mode::On : rotated_sprites == "Off" ? SpriteCache::Mode::Off : SpriteCache::Mode::Auto, rotations > 0 ? rotations : SpriteCache::DEFAULT_ROTATIONS);
+
+        // Dynamic resolution also defaults to "Auto", and "frame_time" is in milliseconds.
+        std::string dynamic_resolution = Application::getConfigMap()["graphics"]["dynamic_resolution"];
+        float frame_time = static_cast<float>(atof(Application::getConfigMap()["graphics"]["frame_time"].c_str())) / 1000.0f;
+        DynamicResolution::setup(dynamic_resolution == "On" ? DynamicResolution::Mode::On : dynamic_resolution == "Off" ? DynamicResolution::Mode::Off : DynamicResolution::Mode::Auto, frame_time > 0.0f ? frame_time : DynamicResolution::DEFAULT_TARGET_TIME);
+
+        // "texture_budget" is in megabytes.
+        int texture_budget = atoi(Application::getConfigMap()["graphics"]["texture_budget"].c_str());
+        TextureCache::setup(texture_budget > 0 ? static_cast<std::size_t>(texture_budget) * 1024 * 1024 : TextureCache::DEFAULT_BUDGET);
 
         int volume = atoi(Application::getConfigMap()["audio"]["volume"].c_str()) * 20;
         Mix_Volume(-1, volume);
@@ -30,11 +63,56 @@ int main(int argc, char* argv[])
             { "GAME", std::make_shared<GameState>() },
             { "OPTIONS", std::make_shared<OptionsMenuState>() }
         };
-        Application::setupStates(states, "MAIN");
+        // "-autopilot <minutes>" lets the game play itself and write metrics to "-metrics <file>".
+        // "-log <file>" writes the log to a file instead of the console.
+        int autopilot_minutes = -1;
+        std::string metrics_file = "SoakMetrics.csv";
+        for (int i = 1; i < argc - 1; i++)
+        {
+            if (std::string(argv[i]) == "-autopilot")
+            {
+                autopilot_minutes = atoi(argv[i + 1]);
+            }
+            else if (std::string(argv[i]) == "-metrics")
+            {
+                metrics_file = argv[i + 1];
+            }
+            else if (std::string(argv[i]) == "-log" && !Log::setFile(argv[i + 1]))
+            {
+                SDL_SetError(("Couldn't create log file: " + std::string(argv[i + 1])).c_str());
+                throw Application::Error::File;
+            }
+        }
+        if (autopilot_minutes >= 0)
+        {
+            Autopilot::enable(autopilot_minutes, metrics_file);
+        }
+
+        // The autopilot is usually left running in the background, so it always runs.
+        if (!Autopilot::isEnabled())
+        {
+            int background_rate = atoi(Application::getConfigMap()["graphics"]["background_rate"].c_str());
+            Background::setup(Background::toPolicy(Application::getConfigMap()["graphics"]["unfocused"]), Background::toPolicy(Application::getConfigMap()["graphics"]["minimised"]), background_rate);
+        }
+        Application::setupStates(states, Autopilot::isEnabled() ? "GAME" : "MAIN");
+
+        // A session can be recorded with "-record <file>" and replayed with "-replay <file>".
+        for (int i = 1; i < argc - 1; i++)
+        {
+            if (std::string(argv[i]) == "-record")
+            {
+                Replay::startRecording(argv[i + 1]);
+            }
+            else if (std::string(argv[i]) == "-replay")
+            {
+                Replay::startPlayback(argv[i + 1]);
+            }
+        }
 
         Application::run();
 
         Mix_FreeMusic(music);
+        SpriteCache::clear();
         Application::shutDown();
     }
     catch (const Application::Error& error)
@@ -42,28 +120,33 @@ int main(int argc, char* argv[])
         switch (error)
         {
         case Application::Error::SDL:
-            OUTPUT("SDL Error: " << SDL_GetError());
+            LOG_ERROR("SDL Error: " << SDL_GetError());
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "SDL Error", SDL_GetError(), Application::getWindow());
             break;
         case Application::Error::IMG:
-            OUTPUT("IMG Error: " << IMG_GetError());
+            LOG_ERROR("IMG Error: " << IMG_GetError());
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "IMG Error", IMG_GetError(), Application::getWindow());
             break;
         case Application::Error::TTF:
-            OUTPUT("TTF Error: " << TTF_GetError());
+            LOG_ERROR("TTF Error: " << TTF_GetError());
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "TTF Error", TTF_GetError(), Application::getWindow());
             break;
         case Application::Error::Mix:
-            OUTPUT("Mix Error: " << Mix_GetError());
+            LOG_ERROR("Mix Error: " << Mix_GetError());
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Mix Error", Mix_GetError(), Application::getWindow());
             break;
         case Application::Error::XML:
-            OUTPUT("XML Error: " << SDL_GetError());
+            LOG_ERROR("XML Error: " << SDL_GetError());
             SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "XML Error", SDL_GetError(), Application::getWindow());
             break;
+        case Application::Error::File:
+            LOG_ERROR("File Error: " << SDL_GetError());
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "File Error", SDL_GetError(), Application::getWindow());
+            break;
         default:
             break;
         }
+        RenderThread::stop();
     }
 
     return 0;